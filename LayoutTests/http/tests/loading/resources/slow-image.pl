@@ -0,0 +1,25 @@
+#!/usr/bin/perl -w
+
+use strict;
+use CGI;
+use Time::HiRes qw(sleep);
+
+my $cgi = new CGI;
+my $delay = $cgi->param('delay');
+$delay = 5000 unless $delay;
+
+# flush the buffers after each print
+select (STDOUT);
+$| = 1;
+
+print "Content-Type: image/gif\n";
+print "Expires: Thu, 01 Dec 2003 16:00:00 GMT\n";
+print "Cache-Control: no-store, no-cache, must-revalidate\n";
+print "Pragma: no-cache\n";
+print "\n";
+
+sleep $delay / 1000;
+
+# A 1x1 transparent GIF.
+binmode STDOUT;
+print pack("H*", "47494638396101000100800000000000ffffff21f90401000000002c00000000010001000002024401003b");
@@ -1468,9 +1468,13 @@ void CodeBlock::markAggregate(MarkStack& markStack)
     for (size_t i = 0; i < m_functionDecls.size(); ++i)
         markStack.append(&m_functionDecls[i]);
 #if ENABLE(JIT_OPTIMIZE_CALL)
-    for (unsigned i = 0; i < numberOfCallLinkInfos(); ++i)
-        if (callLinkInfo(i).isLinked())
-            markStack.append(&callLinkInfo(i).callee);
+    for (unsigned i = 0; i < numberOfCallLinkInfos(); ++i) {
+        CallLinkInfo& info = callLinkInfo(i);
+        if (info.isLinked())
+            markStack.append(&info.callee);
+        for (size_t j = 0; j < info.polymorphicCallees.size(); ++j)
+            markStack.append(&info.polymorphicCallees[j]);
+    }
 #endif
 #if ENABLE(INTERPRETER)
     for (size_t size = m_propertyAccessInstructions.size(), i = 0; i < size; ++i)
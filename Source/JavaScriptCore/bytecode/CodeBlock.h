@@ -100,13 +100,24 @@ namespace JSC {
         {
         }
 
+        // Callees beyond the linked one are dispatched through a chain of stubs,
+        // until the call site sees too many and falls back to the virtual call.
+        static const unsigned maxPolymorphicCallees = 4;
+
         CodeLocationNearCall callReturnLocation;
         CodeLocationDataLabelPtr hotPathBegin;
         CodeLocationNearCall hotPathOther;
         WriteBarrier<JSFunction> callee;
+        CodeLocationLabel polymorphicStub;
+        Vector<WriteBarrier<JSFunction> > polymorphicCallees;
         bool hasSeenShouldRepatch;
         
-        void setUnlinked() { callee.clear(); }
+        void setUnlinked()
+        {
+            callee.clear();
+            polymorphicStub = CodeLocationLabel();
+            polymorphicCallees.clear();
+        }
         bool isLinked() { return callee; }
 
         bool seenOnce()
@@ -207,6 +207,9 @@ void Heap::markRoots()
 
     m_operationInProgress = Collection;
 
+    // The keyed property cache doesn't keep its Structures alive.
+    m_globalData->keyedPropertyCache.clear();
+
     MarkStack& markStack = m_markStack;
     HeapRootMarker heapRootMarker(markStack);
     
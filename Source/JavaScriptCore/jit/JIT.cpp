@@ -605,6 +605,8 @@ void JIT::linkCall(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBlock* ca
         callLinkInfo->callee.set(*globalData, callerCodeBlock->ownerExecutable(), callee);
         repatchBuffer.repatch(callLinkInfo->hotPathBegin, callee);
         repatchBuffer.relink(callLinkInfo->hotPathOther, code);
+        // Leave the slow case on the link trampoline, so further callees get polymorphic stubs.
+        return;
     }
 
     // patch the call so we do not continue to try to link.
@@ -622,11 +624,60 @@ void JIT::linkConstruct(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBloc
         callLinkInfo->callee.set(*globalData, callerCodeBlock->ownerExecutable(), callee);
         repatchBuffer.repatch(callLinkInfo->hotPathBegin, callee);
         repatchBuffer.relink(callLinkInfo->hotPathOther, code);
+        // Leave the slow case on the link trampoline, so further callees get polymorphic stubs.
+        return;
     }
 
     // patch the call so we do not continue to try to link.
     repatchBuffer.relink(callLinkInfo->callReturnLocation, globalData->jitStubs->ctiVirtualConstruct());
 }
+
+void JIT::privateLinkPolymorphicCall(JSFunction* callee, CodePtr code, CallLinkInfo* callLinkInfo, bool isConstruct)
+{
+    ASSERT(callLinkInfo->isLinked());
+
+    // Call sites that see too many callees go megamorphic, and use the virtual call trampoline directly.
+    if (callLinkInfo->polymorphicCallees.size() >= CallLinkInfo::maxPolymorphicCallees) {
+#if ENABLE(SAMPLING_COUNTERS)
+        static SamplingCounter megamorphicCounter("Megamorphic call sites");
+        megamorphicCounter.count();
+#endif
+        RepatchBuffer repatchBuffer(m_codeBlock);
+        repatchBuffer.relink(callLinkInfo->callReturnLocation, isConstruct ? m_globalData->jitStubs->ctiVirtualConstruct() : m_globalData->jitStubs->ctiVirtualCall());
+        return;
+    }
+
+    // regT0 holds callee, regT1 holds argCount, and the callee frame has already been rolled.
+    Jump failureCase = branchPtr(NotEqual, regT0, TrustedImmPtr(callee));
+#if ENABLE(SAMPLING_COUNTERS)
+    static SamplingCounter hitCounter("Polymorphic call stub hits");
+    emitCount(hitCounter);
+#endif
+    compileOpCallInitializeCallFrame();
+    Jump success = jump();
+
+    LinkBuffer patchBuffer(this, m_codeBlock->executablePool(), 0);
+
+    // Chain to the previous stub, or to the link trampoline which will add the next callee.
+    CodeLocationLabel previousStub = callLinkInfo->polymorphicStub;
+    if (!previousStub)
+        previousStub = CodeLocationLabel(isConstruct ? m_globalData->jitStubs->ctiVirtualConstructLink() : m_globalData->jitStubs->ctiVirtualCallLink());
+    patchBuffer.link(failureCase, previousStub);
+    patchBuffer.link(success, CodeLocationLabel(code));
+
+    CodeLocationLabel entryLabel = patchBuffer.finalizeCodeAddendum();
+
+#if ENABLE(SAMPLING_COUNTERS)
+    static SamplingCounter linkCounter("Polymorphic call stubs linked");
+    linkCounter.count();
+#endif
+    callLinkInfo->polymorphicStub = entryLabel;
+    callLinkInfo->polymorphicCallees.append(WriteBarrier<JSFunction>());
+    callLinkInfo->polymorphicCallees.last().set(*m_globalData, m_codeBlock->ownerExecutable(), callee);
+
+    RepatchBuffer repatchBuffer(m_codeBlock);
+    repatchBuffer.relink(callLinkInfo->callReturnLocation, entryLabel);
+}
 #endif // ENABLE(JIT_OPTIMIZE_CALL)
 
 } // namespace JSC
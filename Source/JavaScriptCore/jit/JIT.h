@@ -246,6 +246,12 @@ namespace JSC {
         static void linkCall(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBlock* calleeCodeBlock, CodePtr, CallLinkInfo*, int callerArgCount, JSGlobalData*);
         static void linkConstruct(JSFunction* callee, CodeBlock* callerCodeBlock, CodeBlock* calleeCodeBlock, CodePtr, CallLinkInfo*, int callerArgCount, JSGlobalData*);
 
+        static void linkPolymorphicCall(JSFunction* callee, CodeBlock* callerCodeBlock, CodePtr code, CallLinkInfo* callLinkInfo, JSGlobalData* globalData, bool isConstruct)
+        {
+            JIT jit(globalData, callerCodeBlock);
+            jit.privateLinkPolymorphicCall(callee, code, callLinkInfo, isConstruct);
+        }
+
     private:
         struct JSRInfo {
             DataLabelPtr storeLocation;
@@ -270,6 +276,7 @@ namespace JSC {
         void privateCompileGetByIdChainList(StructureStubInfo*, PolymorphicAccessStructureList*, int, Structure*, StructureChain* chain, size_t count, const Identifier&, const PropertySlot&, size_t cachedOffset, CallFrame* callFrame);
         void privateCompileGetByIdChain(StructureStubInfo*, Structure*, StructureChain*, size_t count, const Identifier&, const PropertySlot&, size_t cachedOffset, ReturnAddressPtr returnAddress, CallFrame* callFrame);
         void privateCompilePutByIdTransition(StructureStubInfo*, Structure*, Structure*, size_t cachedOffset, StructureChain*, ReturnAddressPtr returnAddress, bool direct);
+        void privateLinkPolymorphicCall(JSFunction* callee, CodePtr, CallLinkInfo*, bool isConstruct);
 
         void privateCompileCTIMachineTrampolines(RefPtr<ExecutablePool>* executablePool, JSGlobalData* data, TrampolineStructure *trampolines);
         Label privateCompileCTINativeCall(JSGlobalData*, bool isConstruct = false);
@@ -2112,8 +2112,10 @@ DEFINE_STUB_FUNCTION(void*, vm_lazyLinkCall)
 
     if (!callLinkInfo->seenOnce())
         callLinkInfo->setSeen();
-    else
+    else if (!callLinkInfo->isLinked())
         JIT::linkCall(callee, stackFrame.callFrame->callerFrame()->codeBlock(), codeBlock, codePtr, callLinkInfo, callFrame->argumentCountIncludingThis(), stackFrame.globalData);
+    else
+        JIT::linkPolymorphicCall(callee, stackFrame.callFrame->callerFrame()->codeBlock(), codePtr, callLinkInfo, stackFrame.globalData, false);
 
     return codePtr.executableAddress();
 }
@@ -2146,8 +2148,10 @@ DEFINE_STUB_FUNCTION(void*, vm_lazyLinkConstruct)
 
     if (!callLinkInfo->seenOnce())
         callLinkInfo->setSeen();
-    else
+    else if (!callLinkInfo->isLinked())
         JIT::linkConstruct(callee, stackFrame.callFrame->callerFrame()->codeBlock(), codeBlock, codePtr, callLinkInfo, callFrame->argumentCountIncludingThis(), stackFrame.globalData);
+    else
+        JIT::linkPolymorphicCall(callee, stackFrame.callFrame->callerFrame()->codeBlock(), codePtr, callLinkInfo, stackFrame.globalData, true);
 
     return codePtr.executableAddress();
 }
@@ -2335,6 +2339,15 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_construct_NotJSConstruct)
     VM_THROW_EXCEPTION();
 }
 
+// Own property offsets can be cached for a Structure only if its property table
+// fully describes the object's own properties and holds no accessors.
+static inline bool isCacheableForKeyedAccess(Structure* structure)
+{
+    return !structure->isDictionary()
+        && !structure->typeInfo().overridesGetOwnPropertySlot()
+        && !structure->hasGetterSetterProperties();
+}
+
 DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val)
 {
     STUB_INIT_STACK_FRAME(stackFrame);
@@ -2346,11 +2359,22 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_get_by_val)
     JSValue subscript = stackFrame.args[1].jsValue();
 
     if (LIKELY(baseValue.isCell() && subscript.isString())) {
-        Identifier propertyName(callFrame, asString(subscript)->value(callFrame));
+        const UString& key = asString(subscript)->value(callFrame);
+        Structure* structure = baseValue.asCell()->structure();
+        size_t offset;
+        if (baseValue.isObject() && globalData->keyedPropertyCache.getOffset(structure, key.impl(), offset))
+            return JSValue::encode(asObject(baseValue)->getDirectOffset(offset));
+
+        Identifier propertyName = globalData->keyedPropertyCache.identifier(callFrame, key);
         PropertySlot slot(baseValue.asCell());
         // JSString::value may have thrown, but we shouldn't find a property with a null identifier,
         // so we should miss this case and wind up in the CHECK_FOR_EXCEPTION_AT_END, below.
         if (baseValue.asCell()->fastGetOwnPropertySlot(callFrame, propertyName, slot)) {
+            if (baseValue.isObject() && isCacheableForKeyedAccess(structure)) {
+                offset = structure->get(*globalData, propertyName);
+                if (offset != WTF::notFound)
+                    globalData->keyedPropertyCache.setOffset(structure, key.impl(), offset);
+            }
             JSValue result = slot.getValue(callFrame, propertyName);
             CHECK_FOR_EXCEPTION();
             return JSValue::encode(result);
@@ -3384,6 +3408,27 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_in)
     if (propName.getUInt32(i))
         return JSValue::encode(jsBoolean(baseObj->hasProperty(callFrame, i)));
 
+    KeyedPropertyCache& cache = stackFrame.globalData->keyedPropertyCache;
+    Structure* structure = baseObj->structure();
+    size_t offset;
+    if (propName.isString()) {
+        const UString& key = asString(propName)->value(callFrame);
+        CHECK_FOR_EXCEPTION();
+        if (cache.getOffset(structure, key.impl(), offset))
+            return JSValue::encode(jsBoolean(true));
+
+        Identifier property = cache.identifier(callFrame, key);
+        if (isCacheableForKeyedAccess(structure)) {
+            // Only own properties are cached; anything found further up the prototype chain takes the slow path.
+            offset = structure->get(*stackFrame.globalData, property);
+            if (offset != WTF::notFound) {
+                cache.setOffset(structure, key.impl(), offset);
+                return JSValue::encode(jsBoolean(true));
+            }
+        }
+        return JSValue::encode(jsBoolean(baseObj->hasProperty(callFrame, property)));
+    }
+
     Identifier property(callFrame, propName.toString(callFrame));
     CHECK_FOR_EXCEPTION();
     return JSValue::encode(jsBoolean(baseObj->hasProperty(callFrame, property)));
@@ -3499,7 +3544,14 @@ DEFINE_STUB_FUNCTION(EncodedJSValue, op_del_by_val)
     uint32_t i;
     if (subscript.getUInt32(i))
         result = baseObj->deleteProperty(callFrame, i);
-    else {
+    else if (subscript.isString()) {
+        CHECK_FOR_EXCEPTION();
+        // Deleting always changes the Structure, so only the identifier lookup is cached.
+        const UString& key = asString(subscript)->value(callFrame);
+        CHECK_FOR_EXCEPTION();
+        Identifier property = stackFrame.globalData->keyedPropertyCache.identifier(callFrame, key);
+        result = baseObj->deleteProperty(callFrame, property);
+    } else {
         CHECK_FOR_EXCEPTION();
         Identifier property(callFrame, subscript.toString(callFrame));
         CHECK_FOR_EXCEPTION();
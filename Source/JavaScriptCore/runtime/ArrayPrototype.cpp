@@ -341,7 +341,13 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncConcat(ExecState* exec)
     size_t i = 0;
     size_t argCount = exec->argumentCount();
     while (1) {
-        if (curArg.inherits(&JSArray::s_info)) {
+        if (isJSArray(&exec->globalData(), curArg) && asArray(curArg)->hasDenseStorage()) {
+            // No holes, so there's nothing to look up on the prototype chain.
+            JSArray* curArray = asArray(curArg);
+            unsigned length = curArray->length();
+            for (unsigned k = 0; k < length; ++k)
+                arr->put(exec, n++, curArray->getIndex(k));
+        } else if (curArg.inherits(&JSArray::s_info)) {
             unsigned length = curArg.get(exec, exec->propertyNames().length).toUInt32(exec);
             JSObject* curObject = curArg.toObject(exec);
             for (unsigned k = 0; k < length; ++k) {
@@ -480,6 +486,18 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSlice(ExecState* exec)
     unsigned begin = argumentClampedIndexFromStartOrEnd(exec, 0, length);
     unsigned end = argumentClampedIndexFromStartOrEnd(exec, 1, length, length);
 
+    // Computing begin and end may have run script, so check the array's shape only now.
+    if (isJSArray(&exec->globalData(), thisObj) && asArray(thisObj)->hasDenseStorage() && end <= asArray(thisObj)->length()) {
+        JSArray* array = asArray(thisObj);
+        unsigned count = end > begin ? end - begin : 0;
+        JSGlobalData& globalData = exec->globalData();
+        JSArray* denseResult = new (exec) JSArray(globalData, exec->lexicalGlobalObject()->arrayStructure(), count, CreateCompact);
+        for (unsigned k = 0; k < count; ++k)
+            denseResult->uncheckedSetIndex(globalData, k, array->getIndex(begin + k));
+        denseResult->setLength(count);
+        return JSValue::encode(denseResult);
+    }
+
     unsigned n = 0;
     for (unsigned k = begin; k < end; k++, n++) {
         if (JSValue v = getProperty(exec, thisObj, k))
@@ -577,8 +595,14 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncSplice(ExecState* exec)
     JSArray* resObj = new (exec) JSArray(exec->globalData(), exec->lexicalGlobalObject()->arrayStructure(), deleteCount, CreateCompact);
     JSValue result = resObj;
     JSGlobalData& globalData = exec->globalData();
-    for (unsigned k = 0; k < deleteCount; k++)
-        resObj->uncheckedSetIndex(globalData, k, getProperty(exec, thisObj, k + begin));
+    if (isJSArray(&globalData, thisObj) && asArray(thisObj)->hasDenseStorage() && begin + deleteCount <= asArray(thisObj)->length()) {
+        JSArray* array = asArray(thisObj);
+        for (unsigned k = 0; k < deleteCount; k++)
+            resObj->uncheckedSetIndex(globalData, k, array->getIndex(k + begin));
+    } else {
+        for (unsigned k = 0; k < deleteCount; k++)
+            resObj->uncheckedSetIndex(globalData, k, getProperty(exec, thisObj, k + begin));
+    }
 
     resObj->setLength(deleteCount);
 
@@ -1091,6 +1115,15 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncIndexOf(ExecState* exec)
 
     unsigned index = argumentClampedIndexFromStartOrEnd(exec, 1, length);
     JSValue searchElement = exec->argument(0);
+    if (isJSArray(&exec->globalData(), thisObj)) {
+        JSArray* array = asArray(thisObj);
+        for (; index < length; ++index) {
+            if (UNLIKELY(!array->canGetIndex(index)))
+                break;
+            if (JSValue::strictEqual(exec, searchElement, array->getIndex(index)))
+                return JSValue::encode(jsNumber(index));
+        }
+    }
     for (; index < length; ++index) {
         JSValue e = getProperty(exec, thisObj, index);
         if (!e)
@@ -28,8 +28,10 @@
 #include "Error.h"
 #include "Executable.h"
 #include "PropertyNameArray.h"
+#include <algorithm>
 #include <wtf/AVLTree.h>
 #include <wtf/Assertions.h>
+#include <wtf/MathExtras.h>
 #include <wtf/OwnPtr.h>
 #include <Operations.h>
 
@@ -901,10 +903,25 @@ void JSArray::sortNumeric(ExecState* exec, JSValue compareFunction, CallType cal
     if (!allValuesAreNumbers)
         return sort(exec, compareFunction, callType, callData);
 
-    // For numeric comparison, which is fast, qsort is faster than mergesort. We
-    // also don't require mergesort's stability, since there's no user visible
-    // side-effect from swapping the order of equal primitive values.
-    qsort(storage->m_vector, size, sizeof(JSValue), compareNumbersForQSort);
+    // Sorting unboxed doubles with an inlined comparison is much faster than qsort
+    // calling back through a function pointer. We don't require a stable sort,
+    // since there's no user visible side-effect from swapping the order of equal
+    // primitive values. NaNs don't have a strict weak ordering, so leave those to qsort.
+    Vector<double, 256> numbers(size);
+    bool hasNaN = false;
+    for (size_t i = 0; i < size; ++i) {
+        numbers[i] = storage->m_vector[i].get().uncheckedGetNumber();
+        hasNaN |= isnan(numbers[i]);
+    }
+
+    if (hasNaN)
+        qsort(storage->m_vector, size, sizeof(JSValue), compareNumbersForQSort);
+    else {
+        std::sort(numbers.begin(), numbers.end());
+        // Numbers aren't cells, so no write barrier is needed.
+        for (size_t i = 0; i < size; ++i)
+            storage->m_vector[i].setWithoutWriteBarrier(jsNumber(numbers[i]));
+    }
 
     checkConsistency(SortConsistencyCheck);
 }
@@ -88,6 +88,9 @@ namespace JSC {
         void shiftCount(ExecState*, int count);
         void unshiftCount(ExecState*, int count);
 
+        // True if every index below length() holds a value in the vector, so there are no holes to look through.
+        bool hasDenseStorage() const { return m_storage->m_length <= m_vectorLength && m_storage->m_numValuesInVector == m_storage->m_length; }
+
         bool canGetIndex(unsigned i) { return i < m_vectorLength && m_storage->m_vector[i]; }
         JSValue getIndex(unsigned i)
         {
@@ -303,6 +303,9 @@ JSGlobalData::~JSGlobalData()
     delete emptyList;
 
     delete propertyNames;
+    // The cached identifiers are atomic strings, which remove themselves from
+    // the identifier table when they die, so they have to go before it does.
+    keyedPropertyCache.clear();
     if (globalDataType != Default)
         deleteIdentifierTable(identifierTable);
 
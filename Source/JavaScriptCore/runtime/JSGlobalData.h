@@ -36,6 +36,7 @@
 #include "Strong.h"
 #include "JITStubs.h"
 #include "JSValue.h"
+#include "KeyedPropertyCache.h"
 #include "NumericStrings.h"
 #include "SmallStrings.h"
 #include "Terminator.h"
@@ -181,6 +182,7 @@ namespace JSC {
         const MarkedArgumentBuffer* emptyList; // Lists are supposed to be allocated on the stack to have their elements properly marked, which is not the case here - but this list has nothing to mark.
         SmallStrings smallStrings;
         NumericStrings numericStrings;
+        KeyedPropertyCache keyedPropertyCache;
         DateInstanceCache dateInstanceCache;
         
 #if ENABLE(ASSEMBLER)
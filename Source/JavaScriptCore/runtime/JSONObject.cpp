@@ -38,6 +38,7 @@
 #include "PropertyNameArray.h"
 #include "UStringBuilder.h"
 #include "UStringConcatenate.h"
+#include <wtf/HashMap.h>
 #include <wtf/MathExtras.h>
 
 namespace JSC {
@@ -82,6 +83,22 @@ public:
     void markAggregate(MarkStack&);
 
 private:
+    // Enumerable own property names of objects sharing a Structure, together with
+    // their quoted forms, so arrays of same-shaped objects enumerate each shape once.
+    class CachedPropertyNames : public RefCounted<CachedPropertyNames> {
+    public:
+        static PassRefPtr<CachedPropertyNames> create(PassRefPtr<PropertyNameArrayData> propertyNames) { return adoptRef(new CachedPropertyNames(propertyNames)); }
+
+        PropertyNameArrayData* propertyNames() const { return m_propertyNames.get(); }
+        const UString& quotedPropertyName(unsigned index) const { return m_quotedPropertyNames[index]; }
+
+    private:
+        CachedPropertyNames(PassRefPtr<PropertyNameArrayData>);
+
+        RefPtr<PropertyNameArrayData> m_propertyNames;
+        Vector<UString> m_quotedPropertyNames;
+    };
+
     class Holder {
     public:
         Holder(JSGlobalData&, JSObject*);
@@ -97,12 +114,15 @@ private:
         unsigned m_index;
         unsigned m_size;
         RefPtr<PropertyNameArrayData> m_propertyNames;
+        RefPtr<CachedPropertyNames> m_cachedPropertyNames;
     };
 
     friend class Holder;
 
     static void appendQuotedString(UStringBuilder&, const UString&);
 
+    PassRefPtr<CachedPropertyNames> cachedPropertyNames(JSObject*);
+
     JSValue toJSON(JSValue, const PropertyNameForFunctionCall&);
 
     enum StringifyResult { StringifyFailed, StringifySucceeded, StringifyFailedDueToUndefinedValue };
@@ -124,6 +144,12 @@ private:
     Vector<Holder, 16> m_holderStack;
     UString m_repeatedGap;
     UString m_indent;
+
+    // The Structures used as keys are kept alive by m_cachedStructures, so a key
+    // can't be collected and have its address reused while stringifying.
+    typedef HashMap<Structure*, RefPtr<CachedPropertyNames> > PropertyNameCache;
+    PropertyNameCache m_propertyNameCache;
+    LocalStack<Unknown, 16> m_cachedStructures;
 };
 
 // ------------------------------ helper functions --------------------------------
@@ -204,6 +230,7 @@ Stringifier::Stringifier(ExecState* exec, const Local<Unknown>& replacer, const
     , m_arrayReplacerPropertyNames(exec)
     , m_replacerCallType(CallTypeNone)
     , m_gap(gap(exec, space.get()))
+    , m_cachedStructures(exec->globalData())
 {
     if (!m_replacer.isObject())
         return;
@@ -262,6 +289,11 @@ Local<Unknown> Stringifier::stringify(Handle<Unknown> value)
     return Local<Unknown>(m_exec->globalData(), jsString(m_exec, result.toUString()));
 }
 
+static inline bool needsJSONEscape(UChar c)
+{
+    return c <= 0x1F || c == '"' || c == '\\';
+}
+
 void Stringifier::appendQuotedString(UStringBuilder& builder, const UString& value)
 {
     int length = value.length();
@@ -269,9 +301,21 @@ void Stringifier::appendQuotedString(UStringBuilder& builder, const UString& val
     builder.append('"');
 
     const UChar* data = value.characters();
-    for (int i = 0; i < length; ++i) {
+
+    // Most strings need no escaping at all; copy those in a single append.
+    int firstEscape = 0;
+    while (firstEscape < length && !needsJSONEscape(data[firstEscape]))
+        ++firstEscape;
+    if (firstEscape == length) {
+        builder.append(data, length);
+        builder.append('"');
+        return;
+    }
+    builder.append(data, firstEscape);
+
+    for (int i = firstEscape; i < length; ++i) {
         int start = i;
-        while (i < length && (data[i] > 0x1F && data[i] != '"' && data[i] != '\\'))
+        while (i < length && !needsJSONEscape(data[i]))
             ++i;
         builder.append(data + start, i - start);
         if (i >= length)
@@ -317,6 +361,42 @@ void Stringifier::appendQuotedString(UStringBuilder& builder, const UString& val
     builder.append('"');
 }
 
+Stringifier::CachedPropertyNames::CachedPropertyNames(PassRefPtr<PropertyNameArrayData> propertyNames)
+    : m_propertyNames(propertyNames)
+{
+    PropertyNameArrayData::PropertyNameVector& names = m_propertyNames->propertyNameVector();
+    m_quotedPropertyNames.reserveInitialCapacity(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        UStringBuilder builder;
+        appendQuotedString(builder, names[i].ustring());
+        m_quotedPropertyNames.uncheckedAppend(builder.toUString());
+    }
+}
+
+PassRefPtr<Stringifier::CachedPropertyNames> Stringifier::cachedPropertyNames(JSObject* object)
+{
+    static const size_t maxCachedStructures = 64;
+
+    // Only a non-dictionary Structure whose class doesn't supply its own names
+    // fully determines the result of getOwnPropertyNames.
+    Structure* structure = object->structure();
+    if (structure->isDictionary() || structure->typeInfo().overridesGetPropertyNames())
+        return 0;
+
+    PropertyNameCache::iterator it = m_propertyNameCache.find(structure);
+    if (it != m_propertyNameCache.end())
+        return it->second;
+
+    PropertyNameArray objectPropertyNames(m_exec);
+    object->getOwnPropertyNames(m_exec, objectPropertyNames);
+    RefPtr<CachedPropertyNames> cached = CachedPropertyNames::create(objectPropertyNames.releaseData());
+    if (m_propertyNameCache.size() < maxCachedStructures) {
+        m_cachedStructures.push(JSValue(structure));
+        m_propertyNameCache.add(structure, cached);
+    }
+    return cached.release();
+}
+
 inline JSValue Stringifier::toJSON(JSValue value, const PropertyNameForFunctionCall& propertyName)
 {
     ASSERT(!m_exec->hadException());
@@ -488,6 +568,8 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         } else {
             if (stringifier.m_usingArrayReplacer)
                 m_propertyNames = stringifier.m_arrayReplacerPropertyNames.data();
+            else if ((m_cachedPropertyNames = stringifier.cachedPropertyNames(m_object.get())))
+                m_propertyNames = m_cachedPropertyNames->propertyNames();
             else {
                 PropertyNameArray objectPropertyNames(exec);
                 m_object->getOwnPropertyNames(exec, objectPropertyNames);
@@ -551,7 +633,10 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, UStringBu
         stringifier.startNewLine(builder);
 
         // Append the property name.
-        appendQuotedString(builder, propertyName.ustring());
+        if (m_cachedPropertyNames)
+            builder.append(m_cachedPropertyNames->quotedPropertyName(index));
+        else
+            appendQuotedString(builder, propertyName.ustring());
         builder.append(':');
         if (stringifier.willIndent())
             builder.append(' ');
@@ -162,6 +162,124 @@ JSString* JSString::substringFromRope(ExecState* exec, unsigned substringStart,
     return new (globalData) JSString(globalData, substringFibers[0], substringFibers[1], substringFibers[2]);
 }
 
+// Finds a character by walking a short rope's fibers, returning false when the
+// rope is long enough that flattening it is the better deal.
+bool JSString::characterFromRope(unsigned index, UChar& character)
+{
+    ASSERT(isRope());
+    ASSERT(index < m_length);
+
+    unsigned fiberCount = 0;
+    unsigned fiberStart = 0;
+    RopeIterator end;
+    for (RopeIterator it(m_other.m_fibers.data(), m_fiberCount); it != end; ++it) {
+        if (++fiberCount > substringFromRopeCutoff)
+            return false;
+        StringImpl* fiberString = *it;
+        unsigned fiberEnd = fiberStart + fiberString->length();
+        if (index < fiberEnd) {
+            character = fiberString->characters()[index - fiberStart];
+            return true;
+        }
+        fiberStart = fiberEnd;
+    }
+    ASSERT_NOT_REACHED();
+    return false;
+}
+
+// Compares two strings of the same length chunk by chunk across their fibers,
+// so that neither has to be resolved.
+bool JSString::equalSlowCase(JSString* other)
+{
+    ASSERT(m_length == other->m_length);
+    if (!m_length)
+        return true;
+
+    RopeImpl::Fiber flatFiber = m_value.impl();
+    RopeImpl::Fiber otherFlatFiber = other->m_value.impl();
+    RopeIterator it = isRope() ? RopeIterator(m_other.m_fibers.data(), m_fiberCount) : RopeIterator(&flatFiber, 1);
+    RopeIterator otherIt = other->isRope() ? RopeIterator(other->m_other.m_fibers.data(), other->m_fiberCount) : RopeIterator(&otherFlatFiber, 1);
+
+    unsigned offset = 0;
+    unsigned otherOffset = 0;
+    for (unsigned remaining = m_length; remaining; ) {
+        StringImpl* fiberString = *it;
+        StringImpl* otherFiberString = *otherIt;
+        unsigned chunk = std::min(fiberString->length() - offset, otherFiberString->length() - otherOffset);
+        if (memcmp(fiberString->characters() + offset, otherFiberString->characters() + otherOffset, chunk * sizeof(UChar)))
+            return false;
+        remaining -= chunk;
+        offset += chunk;
+        otherOffset += chunk;
+        if (offset == fiberString->length()) {
+            ++it;
+            offset = 0;
+        }
+        if (otherOffset == otherFiberString->length()) {
+            ++otherIt;
+            otherOffset = 0;
+        }
+    }
+    return true;
+}
+
+size_t JSString::find(UChar character, unsigned start)
+{
+    if (!isRope())
+        return m_value.find(character, start);
+
+    // Searching fiber by fiber never needs more than the rope already holds.
+    unsigned fiberStart = 0;
+    RopeIterator end;
+    for (RopeIterator it(m_other.m_fibers.data(), m_fiberCount); it != end; ++it) {
+        StringImpl* fiberString = *it;
+        unsigned fiberEnd = fiberStart + fiberString->length();
+        if (start < fiberEnd) {
+            size_t position = fiberString->find(character, start > fiberStart ? start - fiberStart : 0);
+            if (position != notFound)
+                return fiberStart + position;
+        }
+        fiberStart = fiberEnd;
+    }
+    return notFound;
+}
+
+#if DUMP_SUBSTRING_STATISTICS
+
+static unsigned numSharedSubstrings;
+static unsigned numCopiedSubstrings;
+static unsigned long long sharedSubstringCharacters;
+static unsigned long long sharedParentCharacters;
+
+void JSString::recordSubstring(unsigned parentLength, unsigned length)
+{
+    if (parentLength < minParentLengthForSharedSubstring) {
+        ++numCopiedSubstrings;
+        return;
+    }
+    ++numSharedSubstrings;
+    sharedSubstringCharacters += length;
+    sharedParentCharacters += parentLength;
+}
+
+struct SubstringStatisticsExitLogger {
+    ~SubstringStatisticsExitLogger();
+};
+
+static SubstringStatisticsExitLogger logger;
+
+SubstringStatisticsExitLogger::~SubstringStatisticsExitLogger()
+{
+    printf("\nJSC::JSString substring statistics\n\n");
+    printf("%u substrings copied out of small parents\n", numCopiedSubstrings);
+    printf("%u substrings sharing a parent buffer\n", numSharedSubstrings);
+    printf("%llu characters referenced, %llu parent characters retained (%.1f%% used)\n",
+        sharedSubstringCharacters, sharedParentCharacters,
+        sharedParentCharacters ? 100.0 * sharedSubstringCharacters / sharedParentCharacters : 0.0);
+}
+
+#endif
+
 JSValue JSString::replaceCharacter(ExecState* exec, UChar character, const UString& replacement)
 {
     if (!isRope()) {
@@ -217,6 +335,9 @@ JSValue JSString::replaceCharacter(ExecState* exec, UChar character, const UStri
 JSString* JSString::getIndexSlowCase(ExecState* exec, unsigned i)
 {
     ASSERT(isRope());
+    UChar c;
+    if (characterFromRope(i, c))
+        return jsSingleCharacterString(exec, c);
     resolveRope(exec);
     // Return a safe no-value result, this should never be used, since the excetion will be thrown.
     if (exec->exception())
@@ -31,6 +31,8 @@
 #include "RopeImpl.h"
 #include "Structure.h"
 
+#define DUMP_SUBSTRING_STATISTICS 0
+
 namespace JSC {
 
     class JSString;
@@ -347,10 +349,20 @@ namespace JSC {
         JSString* getIndex(ExecState*, unsigned);
         JSString* getIndexSlowCase(ExecState*, unsigned);
 
+        // These avoid flattening a rope where walking its fibers is cheaper.
+        UChar characterAt(ExecState*, unsigned);
+        size_t find(UChar, unsigned start);
+        bool equal(ExecState*, JSString*);
+
         JSValue replaceCharacter(ExecState*, UChar, const UString& replacement);
 
         static Structure* createStructure(JSGlobalData& globalData, JSValue proto) { return Structure::create(globalData, proto, TypeInfo(StringType, OverridesGetOwnPropertySlot | NeedsThisConversion), AnonymousSlotCount, 0); }
 
+        static const unsigned minParentLengthForSharedSubstring = 64;
+#if DUMP_SUBSTRING_STATISTICS
+        static void recordSubstring(unsigned parentLength, unsigned length);
+#endif
+
     private:
         JSString(VPtrStealingHackType) 
             : JSCell(VPtrStealingHack)
@@ -360,6 +372,8 @@ namespace JSC {
 
         void resolveRope(ExecState*) const;
         JSString* substringFromRope(ExecState*, unsigned offset, unsigned length);
+        bool characterFromRope(unsigned index, UChar&);
+        bool equalSlowCase(JSString*);
 
         void appendStringInConstruct(unsigned& index, const UString& string)
         {
@@ -505,6 +519,24 @@ namespace JSC {
         return jsSingleCharacterSubstring(exec, m_value, i);
     }
 
+    inline UChar JSString::characterAt(ExecState* exec, unsigned i)
+    {
+        ASSERT(canGetIndex(i));
+        UChar c;
+        if (isRope() && characterFromRope(i, c))
+            return c;
+        return value(exec).characters()[i];
+    }
+
+    inline bool JSString::equal(ExecState*, JSString* other)
+    {
+        if (m_length != other->m_length)
+            return false;
+        if (!isRope() && !other->isRope())
+            return m_value == other->m_value;
+        return equalSlowCase(other);
+    }
+
     inline JSString* jsString(JSGlobalData* globalData, const UString& s)
     {
         int size = s.length();
@@ -550,6 +582,12 @@ namespace JSC {
             if (c <= maxSingleCharacterString)
                 return globalData->smallStrings.singleCharacterString(globalData, c);
         }
+#if DUMP_SUBSTRING_STATISTICS
+        JSString::recordSubstring(s.length(), length);
+#endif
+        // Copy out of small parents: it costs little and keeps them from being retained.
+        if (s.length() < JSString::minParentLengthForSharedSubstring)
+            return fixupVPtr(globalData, new (globalData) JSString(globalData, UString(StringImpl::create(s.characters() + offset, length))));
         return fixupVPtr(globalData, new (globalData) JSString(globalData, UString(StringImpl::create(s.impl(), offset, length)), JSString::HasOtherOwner));
     }
 
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KeyedPropertyCache_h
+#define KeyedPropertyCache_h
+
+#include "Identifier.h"
+#include <wtf/FixedArray.h>
+#include <wtf/HashFunctions.h>
+
+namespace JSC {
+
+    class Structure;
+
+    // Caches the work done by get_by_val, in and del_by_val for string subscripts
+    // that aren't array indices. Keys are the StringImpls of the subscript strings,
+    // which are usually the very same impl on each trip through a loop, so a hit
+    // skips both the identifier table and the property table.
+    //
+    // Structures aren't kept alive by the cache, so it must be cleared whenever
+    // the heap collects.
+    class KeyedPropertyCache {
+    public:
+        KeyedPropertyCache()
+        {
+            clear();
+        }
+
+        // Returns the atomic identifier for the subscript, reusing a cached one if possible.
+        Identifier identifier(ExecState* exec, const UString& key)
+        {
+            IdentifierEntry& entry = m_identifiers[hash(key.impl())];
+            if (entry.key == key.impl())
+                return Identifier(exec, entry.identifier.get());
+            Identifier identifier(exec, key);
+            entry.key = key.impl();
+            entry.identifier = identifier.impl();
+            return identifier;
+        }
+
+        bool getOffset(Structure* structure, StringImpl* key, size_t& offset)
+        {
+            OffsetEntry& entry = m_offsets[hash(structure, key)];
+            if (entry.structure != structure || entry.key != key)
+                return false;
+            offset = entry.offset;
+            return true;
+        }
+
+        // Callers must only cache offsets for Structures whose own properties are
+        // fully described by their property table and which hold no accessors.
+        void setOffset(Structure* structure, StringImpl* key, size_t offset)
+        {
+            OffsetEntry& entry = m_offsets[hash(structure, key)];
+            entry.structure = structure;
+            entry.key = key;
+            entry.offset = offset;
+        }
+
+        // Also drops the cached identifiers, so that the cache does not keep
+        // subscript strings alive from one collection to the next.
+        void clear()
+        {
+            for (size_t i = 0; i < cacheSize; ++i) {
+                m_identifiers[i].key = 0;
+                m_identifiers[i].identifier = 0;
+                m_offsets[i].structure = 0;
+                m_offsets[i].key = 0;
+            }
+        }
+
+    private:
+        static const size_t cacheSize = 64;
+
+        struct IdentifierEntry {
+            RefPtr<StringImpl> key;
+            RefPtr<StringImpl> identifier;
+        };
+
+        struct OffsetEntry {
+            Structure* structure;
+            RefPtr<StringImpl> key;
+            size_t offset;
+        };
+
+        static unsigned hash(StringImpl* key) { return WTF::PtrHash<StringImpl*>::hash(key) & (cacheSize - 1); }
+        static unsigned hash(Structure* structure, StringImpl* key)
+        {
+            return (WTF::PtrHash<Structure*>::hash(structure) ^ WTF::PtrHash<StringImpl*>::hash(key)) & (cacheSize - 1);
+        }
+
+        FixedArray<IdentifierEntry, cacheSize> m_identifiers;
+        FixedArray<OffsetEntry, cacheSize> m_offsets;
+    };
+
+} // namespace JSC
+
+#endif // KeyedPropertyCache_h
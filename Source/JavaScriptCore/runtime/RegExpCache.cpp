@@ -74,4 +74,13 @@ RegExpCache::RegExpCache(JSGlobalData* globalData)
 {
 }
 
+void RegExpCache::clear()
+{
+    m_cacheMap.clear();
+    for (int i = 0; i < maxCacheableEntries; ++i)
+        patternKeyArray[i] = RegExpKey();
+    m_nextKeyToEvict = -1;
+    m_isFull = false;
+}
+
 }
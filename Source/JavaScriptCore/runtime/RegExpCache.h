@@ -44,6 +44,8 @@ public:
     PassRefPtr<RegExp> lookupOrCreate(const UString& patternString, RegExpFlags);
     PassRefPtr<RegExp> create(const UString& patternString, RegExpFlags, RegExpCacheMap::iterator);
     RegExpCache(JSGlobalData* globalData);
+    // Drops every cached RegExp. Those still used by a RegExp object live on.
+    void clear();
 
 private:
     static const unsigned maxCacheablePatternLength = 256;
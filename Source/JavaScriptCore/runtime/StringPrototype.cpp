@@ -484,11 +484,19 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncToString(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
+    JSValue a0 = exec->argument(0);
+    if (thisValue.isString() && a0.isUInt32()) {
+        // Avoids flattening a rope receiver just to read one character.
+        JSString* string = asString(thisValue);
+        uint32_t i = a0.asUInt32();
+        if (string->canGetIndex(i))
+            return JSValue::encode(string->getIndex(exec, i));
+        return JSValue::encode(jsEmptyString(exec));
+    }
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
     UString s = thisValue.toThisString(exec);
     unsigned len = s.length();
-    JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < len)
@@ -504,11 +512,18 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
+    JSValue a0 = exec->argument(0);
+    if (thisValue.isString() && a0.isUInt32()) {
+        JSString* string = asString(thisValue);
+        uint32_t i = a0.asUInt32();
+        if (string->canGetIndex(i))
+            return JSValue::encode(jsNumber(string->characterAt(exec, i)));
+        return JSValue::encode(jsNaN());
+    }
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
     UString s = thisValue.toThisString(exec);
     unsigned len = s.length();
-    JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
         if (i < len)
@@ -538,13 +553,22 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncConcat(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL stringProtoFuncIndexOf(ExecState* exec)
 {
     JSValue thisValue = exec->hostThisValue();
+    JSValue a0 = exec->argument(0);
+    JSValue a1 = exec->argument(1);
+    if (thisValue.isString() && a0.isString() && asString(a0)->length() == 1 && (a1.isUndefined() || a1.isUInt32())) {
+        // Single character searches walk a rope receiver's fibers instead of flattening it.
+        JSString* string = asString(thisValue);
+        unsigned start = a1.isUndefined() ? 0 : min<uint32_t>(a1.asUInt32(), string->length());
+        size_t result = string->find(asString(a0)->characterAt(exec, 0), start);
+        if (result == notFound)
+            return JSValue::encode(jsNumber(-1));
+        return JSValue::encode(jsNumber(result));
+    }
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
         return throwVMTypeError(exec);
     UString s = thisValue.toThisString(exec);
     int len = s.length();
 
-    JSValue a0 = exec->argument(0);
-    JSValue a1 = exec->argument(1);
     UString u2 = a0.toString(exec);
     int pos;
     if (a1.isUndefined())
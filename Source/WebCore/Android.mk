@@ -805,6 +805,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	platform/network/ResourceResponseBase.cpp \
 	\
 	platform/network/android/CookieJarAndroid.cpp \
+	platform/network/android/DNSAndroid.cpp \
 	platform/network/android/ProxyServerAndroid.cpp \
 	platform/network/android/ResourceHandleAndroid.cpp \
 	platform/network/android/ResourceRequestAndroid.cpp \
@@ -870,6 +871,7 @@ LOCAL_SRC_FILES := $(LOCAL_SRC_FILES) \
 	rendering/InlineBox.cpp \
 	rendering/InlineFlowBox.cpp \
 	rendering/InlineTextBox.cpp \
+	rendering/LayoutProfiler.cpp \
 	rendering/LayoutState.cpp \
 	rendering/PointerEventsHitRules.cpp \
 	rendering/RenderApplet.cpp \
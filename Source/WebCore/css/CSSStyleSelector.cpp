@@ -1440,7 +1440,52 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
 
     // Reset the value back before applying properties, so that -webkit-link knows what color to use.
     m_checker.m_matchVisitedPseudoClass = matchVisitedPseudoClass;
-    
+
+    MatchedRuleRanges ranges;
+    ranges.firstUARule = firstUARule;
+    ranges.lastUARule = lastUARule;
+    ranges.firstUserRule = firstUserRule;
+    ranges.lastUserRule = lastUserRule;
+    ranges.firstAuthorRule = firstAuthorRule;
+    ranges.lastAuthorRule = lastAuthorRule;
+
+    bool useMatchedStyleCache = !resolveForRootDefault && !matchVisitedPseudoClass && !visitedStyle && canUseMatchedStyleCache(e);
+    unsigned matchedStyleHash = useMatchedStyleCache ? computeMatchedStyleHash(ranges) : 0;
+    if (const MatchedStyleCacheItem* cacheItem = useMatchedStyleCache ? findFromMatchedStyleCache(matchedStyleHash, ranges) : 0)
+        applyMatchedStyleFromCache(cacheItem);
+    else {
+        RefPtr<RenderStyle> styleBeforeApply;
+        if (useMatchedStyleCache)
+            styleBeforeApply = RenderStyle::clone(style());
+        applyMatchedDeclarations(ranges, resolveForRootDefault);
+        if (useMatchedStyleCache && isCacheableMatchedStyle())
+            addToMatchedStyleCache(matchedStyleHash, ranges, styleBeforeApply.release());
+    }
+
+    // Clean up our style object's display and text decorations (among other fixups).
+    adjustRenderStyle(style(), m_parentStyle, e);
+
+    // Start loading images referenced by this style.
+    loadPendingImages();
+
+    // If we have first-letter pseudo style, do not share this style
+    if (m_style->hasPseudoStyle(FIRST_LETTER))
+        m_style->setUnique();
+
+    if (visitedStyle) {
+        // Add the visited style off the main style.
+        m_style->addCachedPseudoStyle(visitedStyle.release());
+    }
+
+    if (!matchVisitedPseudoClass)
+        initElement(0); // Clear out for the next resolve.
+
+    // Now return the style.
+    return m_style.release();
+}
+
+void CSSStyleSelector::applyMatchedDeclarations(const MatchedRuleRanges& ranges, bool resolveForRootDefault)
+{
     // Now we have all of the matched rules in the appropriate order.  Walk the rules and apply
     // high-priority properties first, i.e., those properties that other properties depend on.
     // The order is (1) high-priority not important, (2) high-priority important, (3) normal not important
@@ -1448,10 +1493,10 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
     m_lineHeightValue = 0;
     applyDeclarations<true>(false, 0, m_matchedDecls.size() - 1);
     if (!resolveForRootDefault) {
-        applyDeclarations<true>(true, firstAuthorRule, lastAuthorRule);
-        applyDeclarations<true>(true, firstUserRule, lastUserRule);
+        applyDeclarations<true>(true, ranges.firstAuthorRule, ranges.lastAuthorRule);
+        applyDeclarations<true>(true, ranges.firstUserRule, ranges.lastUserRule);
     }
-    applyDeclarations<true>(true, firstUARule, lastUARule);
+    applyDeclarations<true>(true, ranges.firstUARule, ranges.lastUARule);
     
     // If our font got dirtied, go ahead and update it now.
     if (m_fontDirty)
@@ -1462,45 +1507,127 @@ PassRefPtr<RenderStyle> CSSStyleSelector::styleForElement(Element* e, RenderStyl
         applyProperty(CSSPropertyLineHeight, m_lineHeightValue);
 
     // Now do the normal priority UA properties.
-    applyDeclarations<false>(false, firstUARule, lastUARule);
+    applyDeclarations<false>(false, ranges.firstUARule, ranges.lastUARule);
     
     // Cache our border and background so that we can examine them later.
     cacheBorderAndBackground();
     
     // Now do the author and user normal priority properties and all the !important properties.
     if (!resolveForRootDefault) {
-        applyDeclarations<false>(false, lastUARule + 1, m_matchedDecls.size() - 1);
-        applyDeclarations<false>(true, firstAuthorRule, lastAuthorRule);
-        applyDeclarations<false>(true, firstUserRule, lastUserRule);
+        applyDeclarations<false>(false, ranges.lastUARule + 1, m_matchedDecls.size() - 1);
+        applyDeclarations<false>(true, ranges.firstAuthorRule, ranges.lastAuthorRule);
+        applyDeclarations<false>(true, ranges.firstUserRule, ranges.lastUserRule);
     }
-    applyDeclarations<false>(true, firstUARule, lastUARule);
+    applyDeclarations<false>(true, ranges.firstUARule, ranges.lastUARule);
 
     ASSERT(!m_fontDirty);
     // If our font got dirtied by one of the non-essential font props, 
     // go ahead and update it a second time.
     if (m_fontDirty)
         updateFont();
-    
-    // Clean up our style object's display and text decorations (among other fixups).
-    adjustRenderStyle(style(), m_parentStyle, e);
+}
 
-    // Start loading images referenced by this style.
-    loadPendingImages();
+bool CSSStyleSelector::canUseMatchedStyleCache(Element* e) const
+{
+    // The cached result is only valid if nothing but the matched declarations
+    // and the parent style went into it. Links depend on their visited state,
+    // unique styles on the element itself (attr(), :empty, positional rules),
+    // and SVG elements may use their own zoom rules.
+    if (!m_parentNode || !m_parentStyle || m_parentStyle == style() || m_style->unique())
+        return false;
+    if (e->isLink() || m_parentStyle->insideLink() != NotInsideLink)
+        return false;
+#if ENABLE(SVG)
+    if (e->isSVGElement())
+        return false;
+#endif
+    // The inline style declaration is edited in place, so its address says
+    // nothing about its contents.
+    if (m_styledElement && m_styledElement->inlineStyleDecl())
+        return false;
+    return true;
+}
 
-    // If we have first-letter pseudo style, do not share this style
-    if (m_style->hasPseudoStyle(FIRST_LETTER))
-        m_style->setUnique();
+bool CSSStyleSelector::isCacheableMatchedStyle() const
+{
+    // Pending images are resolved on the style being built, so a copy would
+    // never start loading them. Appearance depends on the border and
+    // background the UA sheet gave this particular element.
+    if (m_style->unique() || m_style->hasAppearance() || !m_pendingImageProperties.isEmpty())
+        return false;
+    return m_style->zoom() == RenderStyle::initialZoom();
+}
 
-    if (visitedStyle) {
-        // Add the visited style off the main style.
-        m_style->addCachedPseudoStyle(visitedStyle.release());
+unsigned CSSStyleSelector::computeMatchedStyleHash(const MatchedRuleRanges& ranges) const
+{
+    unsigned hash = WTF::intHash((static_cast<uint64_t>(ranges.lastUARule) << 32) | static_cast<unsigned>(ranges.lastAuthorRule));
+    for (unsigned i = 0; i < m_matchedDecls.size(); ++i)
+        hash = WTF::intHash((static_cast<uint64_t>(hash) << 32) | PtrHash<CSSMutableStyleDeclaration*>::hash(m_matchedDecls[i]));
+    // Zero and -1 are the empty and deleted values of the cache.
+    if (!hash || hash == static_cast<unsigned>(-1))
+        hash = 1;
+    return hash;
+}
+
+const CSSStyleSelector::MatchedStyleCacheItem* CSSStyleSelector::findFromMatchedStyleCache(unsigned hash, const MatchedRuleRanges& ranges) const
+{
+    MatchedStyleCache::const_iterator it = m_matchedStyleCache.find(hash);
+    if (it == m_matchedStyleCache.end())
+        return 0;
+    const MatchedStyleCacheItem& item = it->second;
+
+    if (!(item.ranges == ranges) || item.declarations.size() != m_matchedDecls.size())
+        return 0;
+    for (unsigned i = 0; i < m_matchedDecls.size(); ++i) {
+        if (item.declarations[i] != m_matchedDecls[i])
+            return 0;
     }
+    if (item.rootElementStyle != m_rootElementStyle)
+        return 0;
+    // The style before applying holds what was inherited from the parent along
+    // with the pseudo style and dynamic state bits the selectors set.
+    if (*item.styleBeforeApply != *style())
+        return 0;
+    // Non-inherited properties can still pick up values from the parent
+    // through 'inherit'.
+    if (*item.parentStyle != *m_parentStyle)
+        return 0;
+    return &item;
+}
 
-    if (!matchVisitedPseudoClass)
-        initElement(0); // Clear out for the next resolve.
+void CSSStyleSelector::addToMatchedStyleCache(unsigned hash, const MatchedRuleRanges& ranges, PassRefPtr<RenderStyle> styleBeforeApply)
+{
+    if (m_matchedStyleCache.size() >= maxMatchedStyleCacheSize)
+        m_matchedStyleCache.clear();
 
-    // Now return the style.
-    return m_style.release();
+    MatchedStyleCacheItem item;
+    item.declarations.reserveInitialCapacity(m_matchedDecls.size());
+    for (unsigned i = 0; i < m_matchedDecls.size(); ++i)
+        item.declarations.uncheckedAppend(m_matchedDecls[i]);
+    item.ranges = ranges;
+    // Take copies of the styles, the originals may still be modified by their
+    // owners.
+    item.parentStyle = RenderStyle::clone(m_parentStyle);
+    item.rootElementStyle = m_rootElementStyle;
+    item.styleBeforeApply = styleBeforeApply;
+    item.style = RenderStyle::clone(style());
+    m_matchedStyleCache.set(hash, item);
+}
+
+void CSSStyleSelector::applyMatchedStyleFromCache(const MatchedStyleCacheItem* item)
+{
+    // Copying a style drops the per-element bits, so carry over the only one
+    // a shareable style can have at this point.
+    bool affectedByAttributeSelectors = m_style->affectedByAttributeSelectors();
+    m_style = RenderStyle::clone(item->style.get());
+    if (affectedByAttributeSelectors)
+        m_style->setAffectedByAttributeSelectors();
+    m_hasUAAppearance = false;
+}
+
+void CSSStyleSelector::clearMatchedStyleCache()
+{
+    m_matchedStyleCache.clear();
 }
 
 PassRefPtr<RenderStyle> CSSStyleSelector::styleForKeyframe(const RenderStyle* elementStyle, const WebKitCSSKeyframeRule* keyframeRule, KeyframeValue& keyframe)
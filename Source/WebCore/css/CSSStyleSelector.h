@@ -118,6 +118,11 @@ public:
         RenderStyle* parentStyle() const { return m_parentStyle; }
         Element* element() const { return m_element; }
 
+        // Called on a forced style recalc, which can change things the cached
+        // matched styles depend on without creating a new style selector (the
+        // text zoom factor, a web font finishing loading).
+        void clearMatchedStyleCache();
+
     private:
         void initForStyleResolve(Element*, RenderStyle* parentStyle = 0, PseudoId = NOPSEUDO);
         void initElement(Element*);
@@ -205,6 +210,55 @@ public:
 
         void adjustRenderStyle(RenderStyle* styleToAdjust, RenderStyle* parentStyle, Element*);
 
+        struct MatchedRuleRanges {
+            MatchedRuleRanges()
+                : firstUARule(-1)
+                , lastUARule(-1)
+                , firstUserRule(-1)
+                , lastUserRule(-1)
+                , firstAuthorRule(-1)
+                , lastAuthorRule(-1)
+            {
+            }
+
+            bool operator==(const MatchedRuleRanges& o) const
+            {
+                return firstUARule == o.firstUARule && lastUARule == o.lastUARule
+                    && firstUserRule == o.firstUserRule && lastUserRule == o.lastUserRule
+                    && firstAuthorRule == o.firstAuthorRule && lastAuthorRule == o.lastAuthorRule;
+            }
+
+            int firstUARule;
+            int lastUARule;
+            int firstUserRule;
+            int lastUserRule;
+            int firstAuthorRule;
+            int lastAuthorRule;
+        };
+
+        void applyMatchedDeclarations(const MatchedRuleRanges&, bool resolveForRootDefault);
+
+        // The result of applying a list of matched declarations to a style
+        // inheriting from a given parent. Elements that match the same rules
+        // under equal parents (list items, table cells, paragraphs of a long
+        // document) copy the cached result instead of applying every property
+        // again.
+        struct MatchedStyleCacheItem {
+            Vector<RefPtr<CSSMutableStyleDeclaration> > declarations;
+            MatchedRuleRanges ranges;
+            RefPtr<RenderStyle> parentStyle;
+            RefPtr<RenderStyle> rootElementStyle;
+            RefPtr<RenderStyle> styleBeforeApply;
+            RefPtr<RenderStyle> style;
+        };
+
+        bool canUseMatchedStyleCache(Element*) const;
+        bool isCacheableMatchedStyle() const;
+        unsigned computeMatchedStyleHash(const MatchedRuleRanges&) const;
+        const MatchedStyleCacheItem* findFromMatchedStyleCache(unsigned hash, const MatchedRuleRanges&) const;
+        void addToMatchedStyleCache(unsigned hash, const MatchedRuleRanges&, PassRefPtr<RenderStyle> styleBeforeApply);
+        void applyMatchedStyleFromCache(const MatchedStyleCacheItem*);
+
         void addMatchedRule(const RuleData* rule) { m_matchedRules.append(rule); }
         void addMatchedDeclaration(CSSMutableStyleDeclaration* decl);
 
@@ -250,6 +304,12 @@ public:
         typedef HashMap<AtomicStringImpl*, RefPtr<WebKitCSSKeyframesRule> > KeyframesRuleMap;
         KeyframesRuleMap m_keyframesRuleMap;
 
+        // Keyed by computeMatchedStyleHash(). A colliding entry simply replaces
+        // the previous one.
+        typedef HashMap<unsigned, MatchedStyleCacheItem> MatchedStyleCache;
+        MatchedStyleCache m_matchedStyleCache;
+        static const unsigned maxMatchedStyleCacheSize = 256;
+
     public:
         static RenderStyle* styleNotYetAvailable() { return s_styleNotYetAvailable; }
 
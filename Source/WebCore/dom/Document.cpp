@@ -1470,6 +1470,10 @@ void Document::recalcStyle(StyleChange change)
     
     if (m_inStyleRecalc)
         return; // Guard against re-entrancy. -dwh
+
+#ifdef ANDROID_INSTRUMENT
+    LayoutProfiler::CauseScope layoutCause(LayoutProfiler::StyleChange);
+#endif
     
     if (m_hasDirtyStyleSelector)
         recalcStyleSelector();
@@ -1500,6 +1504,9 @@ void Document::recalcStyle(StyleChange change)
     if (change == Force) {
         // style selector may set this again during recalc
         m_hasNodesWithPlaceholderStyle = false;
+
+        if (m_styleSelector)
+            m_styleSelector->clearMatchedStyleCache();
         
         RefPtr<RenderStyle> documentStyle = CSSStyleSelector::styleForDocument(this);
         StyleChange ch = diff(documentStyle.get(), renderer()->style());
@@ -3960,7 +3967,7 @@ void Document::setInPageCache(bool flag)
         m_styleRecalcTimer.stop();
     } else {
         ASSERT(!renderer() || renderer() == m_savedRenderer);
-        ASSERT(m_renderArena);
+        ASSERT(m_renderArena || !m_savedRenderer);
         setRenderer(m_savedRenderer);
         m_savedRenderer = 0;
 
@@ -3972,6 +3979,53 @@ void Document::setInPageCache(bool flag)
     }
 }
 
+void Document::discardRenderTree()
+{
+    ASSERT(m_inPageCache);
+    ASSERT(attached());
+    if (!m_savedRenderer)
+        return;
+
+    clearAXObjectCache();
+
+    // While in the page cache the document has no renderer, which is the
+    // destruction mode detach() relies on, so the renderers of the children go
+    // away without any layout or repaint bookkeeping.
+    for (Node* child = firstChild(); child; child = child->nextSibling()) {
+        if (child->attached())
+            child->detach();
+    }
+
+    m_savedRenderer->destroy();
+    m_savedRenderer = 0;
+    m_renderArena.clear();
+}
+
+void Document::rebuildRenderTree()
+{
+    ASSERT(!m_inPageCache);
+    ASSERT(attached());
+    ASSERT(!renderer());
+
+    // As in attach(), except that documentDidBecomeActive() moves the view
+    // onscreen once the page is restored.
+    if (!m_renderArena)
+        m_renderArena = new RenderArena();
+    setRenderer(new (m_renderArena.get()) RenderView(this, view()));
+
+    recalcStyle(Force);
+
+    RenderObject* render = renderer();
+    setRenderer(0);
+
+    for (Node* child = firstChild(); child; child = child->nextSibling()) {
+        if (!child->attached())
+            child->attach();
+    }
+
+    setRenderer(render);
+}
+
 void Document::documentWillBecomeInactive() 
 {
 #if USE(ACCELERATED_COMPOSITING)
@@ -4711,11 +4765,23 @@ void Document::initDNSPrefetch()
 
     // Inherit DNS prefetch opt-out from parent frame    
     if (Document* parent = parentDocument()) {
-        if (!parent->isDNSPrefetchEnabled())
+        if (!parent->m_isDNSPrefetchEnabled)
             m_isDNSPrefetchEnabled = false;
     }
 }
 
+#if PLATFORM(ANDROID)
+bool Document::isDNSPrefetchEnabled() const
+{
+    // The host cache is shared by the whole profile, so hosts seen while
+    // browsing privately must not be looked up ahead of time.
+    Settings* settings = this->settings();
+    if (settings && settings->privateBrowsingEnabled())
+        return false;
+    return m_isDNSPrefetchEnabled;
+}
+#endif
+
 void Document::parseDNSPrefetchControlHeader(const String& dnsPrefetchControl)
 {
     if (equalIgnoringCase(dnsPrefetchControl, "on") && !m_haveExplicitlyDisabledDNSPrefetch) {
@@ -947,7 +947,11 @@ public:
     CanvasRenderingContext* getCSSCanvasContext(const String& type, const String& name, int width, int height);
     HTMLCanvasElement* getCSSCanvasElement(const String& name);
 
+#if PLATFORM(ANDROID)
+    bool isDNSPrefetchEnabled() const;
+#else
     bool isDNSPrefetchEnabled() const { return m_isDNSPrefetchEnabled; }
+#endif
     void parseDNSPrefetchControlHeader(const String&);
 
     virtual void addMessage(MessageSource, MessageType, MessageLevel, const String& message, unsigned lineNumber, const String& sourceURL, PassRefPtr<ScriptCallStack>);
@@ -960,6 +964,13 @@ public:
 
     bool inPageCache() const { return m_inPageCache; }
     void setInPageCache(bool flag);
+
+    // A document in the page cache can give up its render tree to save memory
+    // and rebuild it once it is out of the cache again. Unlike detach(), the
+    // document stays attached to its frame. view() is not the cached view, so
+    // the caller detaches that view's custom scrollbars first.
+    void discardRenderTree();
+    void rebuildRenderTree();
     
     // Elements can register themselves for the "documentWillBecomeInactive()" and  
     // "documentDidBecomeActive()" callbacks
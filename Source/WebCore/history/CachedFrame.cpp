@@ -27,6 +27,8 @@
 #include "CachedPage.h"
 
 #include "CachedFramePlatformData.h"
+#include "CachedResource.h"
+#include "CachedResourceLoader.h"
 #include "DocumentLoader.h"
 #include "ExceptionCode.h"
 #include "EventNames.h"
@@ -37,6 +39,7 @@
 #include "HistoryItem.h"
 #include "Logging.h"
 #include "PageTransitionEvent.h"
+#include "RenderBox.h"
 #include <wtf/text/CString.h>
 #include <wtf/RefCountedLeakCounter.h>
 
@@ -67,6 +70,7 @@ CachedFrameBase::CachedFrameBase(Frame* frame)
     , m_mousePressNode(frame->eventHandler()->mousePressNode())
     , m_url(frame->document()->url())
     , m_isMainFrame(!frame->tree()->parent())
+    , m_renderTreeDiscarded(false)
 {
 }
 
@@ -84,6 +88,16 @@ void CachedFrameBase::restore()
     ASSERT(m_document->view() == m_view);
 
     Frame* frame = m_view->frame();
+
+    // The layout waits until the frame is fully restored, since its
+    // post-layout tasks can scroll, fire events and update widgets.
+    bool renderTreeRebuilt = m_renderTreeDiscarded;
+    if (m_renderTreeDiscarded) {
+        m_document->rebuildRenderTree();
+        m_renderTreeDiscarded = false;
+        m_view->setNeedsLayout();
+    }
+
     m_cachedFrameScriptData->restore(frame);
 
 #if ENABLE(SVG)
@@ -121,6 +135,19 @@ void CachedFrameBase::restore()
 #endif
 
     m_document->documentDidBecomeActive();
+
+    if (renderTreeRebuilt) {
+        m_document->updateLayout();
+        for (size_t i = 0; i < m_discardedScrollOffsets.size(); ++i) {
+            RenderObject* renderer = m_discardedScrollOffsets[i].first->renderer();
+            if (!renderer || !renderer->isBox())
+                continue;
+            const IntSize& offset = m_discardedScrollOffsets[i].second;
+            toRenderBox(renderer)->setScrollLeft(offset.width());
+            toRenderBox(renderer)->setScrollTop(offset.height());
+        }
+        m_discardedScrollOffsets.clear();
+    }
 }
 
 CachedFrame::CachedFrame(Frame* frame)
@@ -213,6 +240,7 @@ void CachedFrame::clear()
     m_view = 0;
     m_mousePressNode = 0;
     m_url = KURL();
+    m_discardedScrollOffsets.clear();
 
     m_cachedFramePlatformData.clear();
     m_cachedFrameScriptData.clear();
@@ -253,6 +281,51 @@ void CachedFrame::destroy()
     clear();
 }
 
+void CachedFrame::discardRenderTree()
+{
+    ASSERT(m_document && m_document->inPageCache());
+    if (m_renderTreeDiscarded)
+        return;
+
+    // Rebuilding subframes would mean hooking their views back into the new
+    // renderers of their owner elements; keep it simple.
+    if (!m_childFrames.isEmpty())
+        return;
+
+    // A subtree relayout scheduled before the page was cached still points
+    // into the render tree.
+    if (m_view->layoutRoot())
+        return;
+
+    // The scroll offsets of overflow areas live in their RenderLayers.
+    for (Node* node = m_document.get(); node; node = node->traverseNextNode()) {
+        RenderObject* renderer = node->renderer();
+        if (!renderer || !renderer->isBox() || !renderer->hasOverflowClip() || renderer->isRenderView())
+            continue;
+        IntSize offset(toRenderBox(renderer)->scrollLeft(), toRenderBox(renderer)->scrollTop());
+        if (!offset.isZero())
+            m_discardedScrollOffsets.append(std::make_pair(node, offset));
+    }
+
+    // As in Document::detach(), the custom scrollbars and the scroll corner
+    // hold on to renderers in the arena that is about to go away.
+    m_view->detachCustomScrollbars();
+    m_document->discardRenderTree();
+    m_renderTreeDiscarded = true;
+
+    // Nothing of the page is painted until it is restored, and the images
+    // decode again then. The renderers of the page were its image clients,
+    // so an image that still has clients is in use by a live page.
+    const CachedResourceLoader::DocumentResourceMap& resources = m_document->cachedResourceLoader()->allCachedResources();
+    CachedResourceLoader::DocumentResourceMap::const_iterator end = resources.end();
+    for (CachedResourceLoader::DocumentResourceMap::const_iterator it = resources.begin(); it != end; ++it) {
+        if (it->second->type() == CachedResource::ImageResource && !it->second->hasClients())
+            it->second->destroyDecodedData();
+    }
+
+    LOG(PageCache, "Discarded the render tree of CachedFrame with url '%s'\n", m_url.string().utf8().data());
+}
+
 void CachedFrame::setCachedFramePlatformData(PassOwnPtr<CachedFramePlatformData> data)
 {
     m_cachedFramePlatformData = data;
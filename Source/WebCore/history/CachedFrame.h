@@ -26,10 +26,12 @@
 #ifndef CachedFrame_h
 #define CachedFrame_h
 
+#include "IntSize.h"
 #include "KURL.h"
 #include "ScriptCachedFrameData.h"
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
 
 namespace WebCore {
 
@@ -64,6 +66,9 @@ protected:
     OwnPtr<ScriptCachedFrameData> m_cachedFrameScriptData;
     OwnPtr<CachedFramePlatformData> m_cachedFramePlatformData;
     bool m_isMainFrame;
+    bool m_renderTreeDiscarded;
+    // Where the overflow areas of a discarded render tree were scrolled to.
+    Vector<std::pair<RefPtr<Node>, IntSize> > m_discardedScrollOffsets;
     
     CachedFrameVector m_childFrames;
 };
@@ -76,6 +81,11 @@ public:
     void clear();
     void destroy();
 
+    // Drops the render tree and decoded images of a frame that has no
+    // subframes. They are rebuilt when the frame is restored.
+    void discardRenderTree();
+    bool renderTreeDiscarded() const { return m_renderTreeDiscarded; }
+
     void setCachedFramePlatformData(PassOwnPtr<CachedFramePlatformData>);
     CachedFramePlatformData* cachedFramePlatformData();
 
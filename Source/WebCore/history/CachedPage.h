@@ -52,6 +52,9 @@ public:
 
     void markForVistedLinkStyleRecalc() { m_needStyleRecalcForVisitedLinks = true; }
 
+    void discardRenderTree() { m_cachedMainFrame->discardRenderTree(); }
+    bool renderTreeDiscarded() const { return m_cachedMainFrame->renderTreeDiscarded(); }
+
 private:
     CachedPage(Page*);
 
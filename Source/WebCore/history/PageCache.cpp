@@ -46,6 +46,7 @@
 #include "Settings.h"
 #include "SharedWorkerRepository.h"
 #include "SystemTime.h"
+#include <limits.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 #include <wtf/text/StringConcatenate.h>
@@ -237,6 +238,7 @@ PageCache* pageCache()
 
 PageCache::PageCache()
     : m_capacity(0)
+    , m_renderedCapacity(INT_MAX)
     , m_size(0)
     , m_head(0)
     , m_tail(0)
@@ -328,6 +330,14 @@ void PageCache::setCapacity(int capacity)
     prune();
 }
 
+void PageCache::setRenderedCapacity(int capacity)
+{
+    ASSERT(capacity >= 0);
+    m_renderedCapacity = max(capacity, 0);
+
+    discardOldRenderTrees();
+}
+
 int PageCache::frameCount() const
 {
     int frameCount = 0;
@@ -368,6 +378,7 @@ void PageCache::add(PassRefPtr<HistoryItem> prpItem, Page* page)
     ++m_size;
     
     prune();
+    discardOldRenderTrees();
 }
 
 CachedPage* PageCache::get(HistoryItem* item)
@@ -409,6 +420,18 @@ void PageCache::prune()
     }
 }
 
+void PageCache::discardOldRenderTrees()
+{
+    int rendered = 0;
+    for (HistoryItem* current = m_head; current; current = current->m_next) {
+        ASSERT(current->m_cachedPage);
+        if (rendered < m_renderedCapacity && !current->m_cachedPage->renderTreeDiscarded())
+            ++rendered;
+        else
+            current->m_cachedPage->discardRenderTree();
+    }
+}
+
 void PageCache::addToLRUList(HistoryItem* item)
 {
     item->m_next = m_head;
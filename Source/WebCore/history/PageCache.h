@@ -48,6 +48,11 @@ namespace WebCore {
 
         void setCapacity(int); // number of pages to cache
         int capacity() { return m_capacity; }
+
+        // Number of most recent pages that keep their render tree and decoded
+        // images. Older pages are kept compact and laid out again on restore.
+        void setRenderedCapacity(int);
+        int renderedCapacity() { return m_renderedCapacity; }
         
         void add(PassRefPtr<HistoryItem>, Page*); // Prunes if capacity() is exceeded.
         void remove(HistoryItem*);
@@ -73,11 +78,13 @@ namespace WebCore {
         void removeFromLRUList(HistoryItem*);
 
         void prune();
+        void discardOldRenderTrees();
 
         void autorelease(PassRefPtr<CachedPage>);
         void releaseAutoreleasedPagesNowOrReschedule(Timer<PageCache>*);
 
         int m_capacity;
+        int m_renderedCapacity;
         int m_size;
 
         // LRU List
@@ -252,7 +252,11 @@ void HTMLLinkElement::process()
         Settings* settings = document()->settings();
         // FIXME: The href attribute of the link element can be in "//hostname" form, and we shouldn't attempt
         // to complete that as URL <https://bugs.webkit.org/show_bug.cgi?id=48857>.
-        if (settings && settings->dnsPrefetchingEnabled() && m_url.isValid() && !m_url.isEmpty())
+        if (settings && settings->dnsPrefetchingEnabled() && m_url.isValid() && !m_url.isEmpty()
+#if PLATFORM(ANDROID)
+            && !settings->privateBrowsingEnabled()
+#endif
+            )
             ResourceHandle::prepareForURL(m_url);
     }
 
@@ -196,6 +196,7 @@ void CSSPreloadScanner::emitRule()
         String value = parseCSSStringOrURL(m_ruleValue.data(), m_ruleValue.size());
         if (!value.isEmpty()) {
             ResourceRequest request(m_document->completeURL(value));
+            m_document->cachedResourceLoader()->prefetchHost(request.url());
             m_document->cachedResourceLoader()->preload(CachedResource::CSSStyleSheet, request, String(), m_scanningBody);
         }
         m_state = Initial;
@@ -61,7 +61,8 @@ public:
         if (m_tagName != imgTag
             && m_tagName != inputTag
             && m_tagName != linkTag
-            && m_tagName != scriptTag)
+            && m_tagName != scriptTag
+            && m_tagName != iframeTag)
             return;
 
         for (HTMLToken::AttributeList::const_iterator iter = attributes.begin();
@@ -72,7 +73,7 @@ public:
             if (attributeName == charsetAttr)
                 m_charset = attributeValue;
 
-            if (m_tagName == scriptTag || m_tagName == imgTag) {
+            if (m_tagName == scriptTag || m_tagName == imgTag || m_tagName == iframeTag) {
                 if (attributeName == srcAttr)
                     setUrlToLoad(attributeValue);
             } else if (m_tagName == linkTag) {
@@ -127,6 +128,10 @@ public:
 
         CachedResourceLoader* cachedResourceLoader = document->cachedResourceLoader();
         ResourceRequest request = document->completeURL(m_urlToLoad);
+        // Even where there is nothing to preload, or the preload has to wait
+        // for the body, the host can be looked up now.
+        if (m_tagName != inputTag || m_inputIsImage)
+            cachedResourceLoader->prefetchHost(request.url());
         if (m_tagName == scriptTag)
             cachedResourceLoader->preload(CachedResource::Script, request, m_charset, scanningBody);
         else if (m_tagName == imgTag || (m_tagName == inputTag && m_inputIsImage))
@@ -250,8 +250,12 @@ void HTMLScriptRunner::requestParsingBlockingScript(Element* element)
     // We only care about a load callback if cachedScript is not already
     // in the cache.  Callers will attempt to run the m_parsingBlockingScript
     // if possible before returning control to the parser.
-    if (!m_parsingBlockingScript.cachedScript()->isLoaded())
+    if (!m_parsingBlockingScript.cachedScript()->isLoaded()) {
+        // Nothing else in the document can be parsed until this script
+        // arrives, so it goes ahead of anything still waiting to load.
+        m_parsingBlockingScript.cachedScript()->setLoadPriority(ResourceLoadPriorityHighest);
         watchForLoad(m_parsingBlockingScript);
+    }
 }
 
 void HTMLScriptRunner::requestDeferredScript(Element* element)
@@ -83,6 +83,7 @@
 #include "PluginDocument.h"
 #include "ProgressTracker.h"
 #include "ResourceHandle.h"
+#include "ResourceLoadScheduler.h"
 #include "ResourceRequest.h"
 #include "SchemeRegistry.h"
 #include "ScrollAnimator.h"
@@ -2503,7 +2504,7 @@ void FrameLoader::checkLoadCompleteForThisFrame()
 #ifdef ANDROID_INSTRUMENT
             if (!m_frame->tree()->parent() && m_frame->document()->renderArena())
                 android::TimeCounter::report(m_URL, cache()->getLiveSize(), cache()->getDeadSize(),
-                        m_frame->document()->renderArena()->reportPoolSize());
+                        m_frame->document()->renderArena());
 #endif
             return;
         }
@@ -2561,6 +2562,9 @@ void FrameLoader::didFirstLayout()
 
 void FrameLoader::didFirstVisuallyNonEmptyLayout()
 {
+    if (isLoadingMainFrame() && m_documentLoader && m_documentLoader->timing()->navigationStart)
+        resourceLoadScheduler()->didFirstVisuallyNonEmptyLayout(currentTime() - m_documentLoader->timing()->navigationStart);
+
     m_client->dispatchDidFirstVisuallyNonEmptyLayout();
 }
 
@@ -49,6 +49,10 @@ static unsigned maxRequestsInFlightPerHost;
 static const unsigned maxRequestsInFlightForNonHTTPProtocols = 10000;
 static const unsigned maxRequestsInFlightPerHost = 10000;
 #endif
+// Loads at the highest priority, stylesheets and scripts the parser waits for,
+// are on the critical path and may go over the per-host limit by this much
+// rather than wait for an image to finish.
+static const int extraRequestsInFlightForHighestPriority = 2;
 
 ResourceLoadScheduler::HostInformation* ResourceLoadScheduler::hostForURL(const KURL& url, CreateHostPolicy createHostPolicy)
 {
@@ -77,6 +81,8 @@ ResourceLoadScheduler::ResourceLoadScheduler()
     , m_requestTimer(this, &ResourceLoadScheduler::requestTimerFired)
     , m_isSuspendingPendingRequests(false)
     , m_isSerialLoadingEnabled(false)
+    , m_reprioritizedLoads(0)
+    , m_lastTimeToFirstPaint(0)
 {
 #if REQUEST_MANAGEMENT_ENABLED
     maxRequestsInFlightPerHost = initializeMaximumHTTPConnectionCountPerHost();
@@ -152,6 +158,34 @@ void ResourceLoadScheduler::crossOriginRedirectReceived(ResourceLoader* resource
     oldHost->remove(resourceLoader);
 }
 
+void ResourceLoadScheduler::reprioritize(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    ASSERT(resourceLoader);
+    ASSERT(priority != ResourceLoadPriorityUnresolved);
+#if REQUEST_MANAGEMENT_ENABLED
+    HostInformation* host = hostForURL(resourceLoader->url());
+    // Loads that are already in progress keep the priority they started with.
+    if (!host || !host->reprioritize(resourceLoader, priority))
+        return;
+
+    resourceLoader->setRequestPriority(priority);
+    LOG(ResourceLoading, "ResourceLoadScheduler::reprioritize resource %p '%s' to %d", resourceLoader, resourceLoader->url().string().latin1().data(), priority);
+    ++m_reprioritizedLoads;
+    if (priority > ResourceLoadPriorityLow && !m_isSuspendingPendingRequests)
+        servePendingRequests(host, priority);
+#else
+    UNUSED_PARAM(resourceLoader);
+    UNUSED_PARAM(priority);
+#endif
+}
+
+void ResourceLoadScheduler::didFirstVisuallyNonEmptyLayout(double timeSinceNavigationStart)
+{
+    LOG(ResourceLoading, "ResourceLoadScheduler::didFirstVisuallyNonEmptyLayout after %.3fs, %u loads reprioritized", timeSinceNavigationStart, m_reprioritizedLoads);
+    m_lastTimeToFirstPaint = timeSinceNavigationStart;
+    m_reprioritizedLoads = 0;
+}
+
 void ResourceLoadScheduler::servePendingRequests(ResourceLoadPriority minimumPriority)
 {
     LOG(ResourceLoading, "ResourceLoadScheduler::servePendingRequests. m_isSuspendingPendingRequests=%d", m_isSuspendingPendingRequests); 
@@ -272,6 +306,24 @@ void ResourceLoadScheduler::HostInformation::remove(ResourceLoader* resourceLoad
     }
 }
 
+bool ResourceLoadScheduler::HostInformation::reprioritize(ResourceLoader* resourceLoader, ResourceLoadPriority newPriority)
+{
+    for (int priority = ResourceLoadPriorityHighest; priority >= ResourceLoadPriorityLowest; --priority) {
+        RequestQueue::iterator end = m_requestsPending[priority].end();
+        for (RequestQueue::iterator it = m_requestsPending[priority].begin(); it != end; ++it) {
+            if (*it == resourceLoader) {
+                if (priority == newPriority)
+                    return false;
+                RefPtr<ResourceLoader> protector(resourceLoader);
+                m_requestsPending[priority].remove(it);
+                m_requestsPending[newPriority].append(resourceLoader);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 bool ResourceLoadScheduler::HostInformation::hasRequests() const
 {
     if (!m_requestsLoading.isEmpty())
@@ -287,7 +339,12 @@ bool ResourceLoadScheduler::HostInformation::limitRequests(ResourceLoadPriority
 {
     if (priority == ResourceLoadPriorityVeryLow && !m_requestsLoading.isEmpty())
         return true;
-    return m_requestsLoading.size() >= (resourceLoadScheduler()->isSerialLoadingEnabled() ? 1 : m_maxRequestsInFlight);
+    if (resourceLoadScheduler()->isSerialLoadingEnabled())
+        return m_requestsLoading.size() >= 1;
+    int maxRequestsInFlight = m_maxRequestsInFlight;
+    if (priority == ResourceLoadPriorityHighest)
+        maxRequestsInFlight += extraRequestsInFlightForHighestPriority;
+    return m_requestsLoading.size() >= maxRequestsInFlight;
 }
 
 } // namespace WebCore
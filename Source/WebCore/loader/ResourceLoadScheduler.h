@@ -55,6 +55,15 @@ public:
     void addMainResourceLoad(ResourceLoader*);
     void remove(ResourceLoader*);
     void crossOriginRedirectReceived(ResourceLoader*, const KURL& redirectURL);
+
+    // Moves a load that has not started yet to another priority queue. Loads
+    // that become more urgent are started right away if their host allows.
+    void reprioritize(ResourceLoader*, ResourceLoadPriority);
+
+    // Reports how long the main frame took to show something, together with
+    // how often loads were reprioritized on the way.
+    void didFirstVisuallyNonEmptyLayout(double timeSinceNavigationStart);
+    double lastTimeToFirstPaint() const { return m_lastTimeToFirstPaint; }
     
     void servePendingRequests(ResourceLoadPriority minimumPriority = ResourceLoadPriorityVeryLow);
     void suspendPendingRequests();
@@ -81,6 +90,7 @@ private:
         void schedule(ResourceLoader*, ResourceLoadPriority = ResourceLoadPriorityVeryLow);
         void addLoadInProgress(ResourceLoader*);
         void remove(ResourceLoader*);
+        bool reprioritize(ResourceLoader*, ResourceLoadPriority);
         bool hasRequests() const;
         bool limitRequests(ResourceLoadPriority) const;
 
@@ -111,6 +121,9 @@ private:
 
     bool m_isSuspendingPendingRequests;
     bool m_isSerialLoadingEnabled;
+
+    unsigned m_reprioritizedLoads;
+    double m_lastTimeToFirstPaint;
 };
 
 ResourceLoadScheduler* resourceLoadScheduler();
@@ -61,6 +61,9 @@ PassRefPtr<SharedBuffer> ResourceLoader::resourceData()
 ResourceLoader::ResourceLoader(Frame* frame, bool sendResourceLoadCallbacks, bool shouldContentSniff)
     : m_frame(frame)
     , m_documentLoader(frame->loader()->activeDocumentLoader())
+#if PLATFORM(ANDROID)
+    , m_receivingSegment(0)
+#endif
     , m_identifier(0)
     , m_reachedTerminalState(false)
     , m_cancelled(false)
@@ -217,6 +220,14 @@ void ResourceLoader::addData(const char* data, int length, bool allAtOnce)
         if (m_resourceData)
             m_resourceData->append(data, length);
     } else {
+#if PLATFORM(ANDROID)
+        if (m_receivingSegment && data == m_receivingSegment->data() && static_cast<unsigned>(length) == m_receivingSegment->size()) {
+            if (!m_resourceData)
+                m_resourceData = SharedBuffer::create();
+            m_resourceData->append(m_receivingSegment);
+            return;
+        }
+#endif
         if (!m_resourceData)
             m_resourceData = SharedBuffer::create(data, length);
         else
@@ -440,6 +451,20 @@ void ResourceLoader::didReceiveData(ResourceHandle*, const char* data, int lengt
     InspectorInstrumentation::didReceiveResourceData(cookie);
 }
 
+#if PLATFORM(ANDROID)
+void ResourceLoader::didReceiveDataSegment(ResourceHandle* handle, SharedBufferSegment* segment, int encodedDataLength)
+{
+    RefPtr<ResourceLoader> protector(this);
+    RefPtr<SharedBufferSegment> protectSegment(segment);
+
+    // Subclasses still see plain bytes; addData() recognizes them as the
+    // segment and keeps a reference instead of copying them.
+    m_receivingSegment = segment;
+    didReceiveData(handle, segment->data(), segment->size(), encodedDataLength);
+    m_receivingSegment = 0;
+}
+#endif
+
 void ResourceLoader::didFinishLoading(ResourceHandle*, double finishTime)
 {
     didFinishLoading(finishTime);
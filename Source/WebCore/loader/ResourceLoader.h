@@ -117,6 +117,10 @@ namespace WebCore {
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
         virtual void didReceiveDataArray(ResourceHandle*, CFArrayRef dataArray);
 #endif
+#if PLATFORM(ANDROID)
+        virtual bool supportsDataSegments() { return true; }
+        virtual void didReceiveDataSegment(ResourceHandle*, SharedBufferSegment*, int encodedDataLength);
+#endif
 #if USE(PROTECTION_SPACE_AUTH_CALLBACK)
         virtual bool canAuthenticateAgainstProtectionSpace(ResourceHandle*, const ProtectionSpace& protectionSpace) { return canAuthenticateAgainstProtectionSpace(protectionSpace); }
 #endif
@@ -146,10 +150,12 @@ namespace WebCore {
 #if ENABLE(OFFLINE_WEB_APPLICATIONS)
         friend class ApplicationCacheHost;  // for access to request()
 #endif
-        friend class ResourceLoadScheduler; // for access to start()
+        friend class ResourceLoadScheduler; // for access to start() and setRequestPriority()
         // start() actually sends the load to the network (unless the load is being 
         // deferred) and should only be called by ResourceLoadScheduler or setDefersLoading().
         void start();
+        // Only meaningful before start(); the priority is handed to the network layer with the request.
+        void setRequestPriority(ResourceLoadPriority priority) { m_request.setPriority(priority); }
         
         virtual void didCancel(const ResourceError&);
         void didFinishLoadingOnePart(double finishTime);
@@ -166,6 +172,10 @@ namespace WebCore {
     private:
         ResourceRequest m_request;
         RefPtr<SharedBuffer> m_resourceData;
+#if PLATFORM(ANDROID)
+        // The segment being delivered by didReceiveDataSegment(), if any.
+        SharedBufferSegment* m_receivingSegment;
+#endif
         
         unsigned long m_identifier;
 
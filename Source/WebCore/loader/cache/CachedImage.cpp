@@ -349,6 +349,14 @@ void CachedImage::decodedSizeChanged(const Image* image, int delta)
     setDecodedSize(decodedSize() + delta);
 }
 
+void CachedImage::didDecode(const Image* image, double decodeTime)
+{
+    if (image != m_image)
+        return;
+
+    didSpendDecodeTime(decodeTime);
+}
+
 void CachedImage::didDraw(const Image* image)
 {
     if (image != m_image)
@@ -80,6 +80,7 @@ public:
 
     // ImageObserver
     virtual void decodedSizeChanged(const Image* image, int delta);
+    virtual void didDecode(const Image*, double decodeTime);
     virtual void didDraw(const Image*);
 
     virtual bool shouldPauseAnimation(const Image*);
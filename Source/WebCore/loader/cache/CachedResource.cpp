@@ -91,6 +91,8 @@ CachedResource::CachedResource(const ResourceRequest& request, Type type)
     , m_loadPriority(defaultPriorityForResourceType(type))
     , m_responseTimestamp(currentTime())
     , m_lastDecodedAccessTime(0)
+    , m_decodeTime(0)
+    , m_evictionBase(0)
     , m_encodedSize(0)
     , m_decodedSize(0)
     , m_accessCount(0)
@@ -638,9 +640,11 @@ unsigned CachedResource::overheadSize() const
     
 void CachedResource::setLoadPriority(ResourceLoadPriority loadPriority) 
 { 
-    if (loadPriority == ResourceLoadPriorityUnresolved)
+    if (loadPriority == ResourceLoadPriorityUnresolved || loadPriority == m_loadPriority)
         return;
     m_loadPriority = loadPriority;
+    if (m_request)
+        m_request->setPriority(loadPriority);
 }
 
 }
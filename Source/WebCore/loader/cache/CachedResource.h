@@ -148,6 +148,10 @@ public:
     unsigned accessCount() const { return m_accessCount; }
     void increaseAccessCount() { m_accessCount++; }
 
+    // The longest a single decode of the resource's data took. The cache uses
+    // it to estimate what dropping the decoded data would cost.
+    double decodeTime() const { return m_decodeTime; }
+
     // Computes the status of an object after loading.  
     // Updates the expire date on the cache entry file
     void finish();
@@ -231,6 +235,11 @@ protected:
     void setEncodedSize(unsigned);
     void setDecodedSize(unsigned);
     void didAccessDecodedData(double timeStamp);
+    void didSpendDecodeTime(double decodeTime)
+    {
+        if (decodeTime > m_decodeTime)
+            m_decodeTime = decodeTime;
+    }
 
     bool isSafeToMakePurgeable() const;
     
@@ -258,6 +267,8 @@ private:
     RefPtr<CachedMetadata> m_cachedMetadata;
 
     double m_lastDecodedAccessTime; // Used as a "thrash guard" in the cache
+    double m_decodeTime;
+    double m_evictionBase; // The cache's eviction inflation when the resource was last accessed.
 
     unsigned m_encodedSize;
     unsigned m_decodedSize;
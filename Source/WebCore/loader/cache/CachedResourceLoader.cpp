@@ -45,6 +45,7 @@
 #include "Logging.h"
 #include "MemoryCache.h"
 #include "PingLoader.h"
+#include "ResourceHandle.h"
 #include "ResourceLoadScheduler.h"
 #include "SecurityOrigin.h"
 #include "Settings.h"
@@ -785,6 +786,26 @@ void CachedResourceLoader::clearPendingPreloads()
     m_pendingPreloads.clear();
 }
 
+// Pages full of widgets and ads can reference dozens of hosts. Past the first
+// few, speculative lookups mostly compete with the loads themselves.
+static const unsigned maxPrefetchedHostsPerDocument = 16;
+
+void CachedResourceLoader::prefetchHost(const KURL& url)
+{
+    if (!m_document || !m_document->isDNSPrefetchEnabled())
+        return;
+    if (!url.protocolInHTTPFamily() || url.host().isEmpty())
+        return;
+    // The document's own host was resolved to load the document.
+    if (equalIgnoringCase(url.host(), m_document->url().host()))
+        return;
+    if (m_prefetchedHosts.size() >= maxPrefetchedHostsPerDocument)
+        return;
+    if (!m_prefetchedHosts.add(url.host().lower()).second)
+        return;
+    ResourceHandle::prepareForURL(url);
+}
+
 #if PRELOAD_DEBUG
 void CachedResourceLoader::printPreloadStats()
 {
@@ -113,6 +113,11 @@ public:
     void preload(CachedResource::Type, ResourceRequest&, const String& charset, bool referencedFromBody);
     void checkForPendingPreloads();
     void printPreloadStats();
+
+    // Asks the network layer to resolve the host of |url| ahead of a load that
+    // is likely to need it. Each cross-origin host is only asked for once, and
+    // only the first few hosts of a document are.
+    void prefetchHost(const KURL&);
     
 private:
     CachedResource* requestResource(CachedResource::Type, ResourceRequest&, const String& charset, ResourceLoadPriority = ResourceLoadPriorityUnresolved, bool isPreload = false);
@@ -146,6 +151,7 @@ private:
         String m_charset;
     };
     Deque<PendingPreload> m_pendingPreloads;
+    HashSet<String> m_prefetchedHosts;
 
     Timer<CachedResourceLoader> m_loadDoneActionTimer;
     
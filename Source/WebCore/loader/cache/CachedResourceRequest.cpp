@@ -136,6 +136,12 @@ PassRefPtr<CachedResourceRequest> CachedResourceRequest::load(CachedResourceLoad
     return request.release();
 }
 
+void CachedResourceRequest::setPriority(ResourceLoadPriority priority)
+{
+    if (m_loader)
+        resourceLoadScheduler()->reprioritize(m_loader.get(), priority);
+}
+
 void CachedResourceRequest::willSendRequest(SubresourceLoader*, ResourceRequest&, const ResourceResponse&)
 {
     m_resource->setRequestedFromNetworkingLayer();
@@ -23,6 +23,7 @@
 #define CachedResourceRequest_h
 
 #include "FrameLoaderTypes.h"
+#include "ResourceLoadPriority.h"
 #include "SubresourceLoader.h"
 #include "SubresourceLoaderClient.h"
 #include <wtf/HashMap.h>
@@ -40,6 +41,7 @@ namespace WebCore {
         static PassRefPtr<CachedResourceRequest> load(CachedResourceLoader*, CachedResource*, bool incremental, SecurityCheckPolicy, bool sendResourceLoadCallbacks);
         ~CachedResourceRequest();
         void didFail(bool cancelled = false);
+        void setPriority(ResourceLoadPriority);
 
         CachedResourceLoader* cachedResourceLoader() const { return m_cachedResourceLoader; }
 
@@ -39,6 +39,7 @@
 #include "ResourceHandle.h"
 #include "SecurityOrigin.h"
 #include "SecurityOriginHash.h"
+#include <algorithm>
 #include <stdio.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
@@ -55,6 +56,12 @@ static const int cDefaultCacheCapacity = 8192 * 1024;
 static const double cMinDelayBeforeLiveDecodedPrune = 1; // Seconds.
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
 static const double cDefaultDecodedDataDeletionInterval = 0;
+// Default weights of the cost model, in bytes. A second of decoding is worth
+// about as much as reading 5MB back from the disk cache, and parsing a byte
+// of script or style costs about as much as fetching it.
+static const double cDefaultDecodeSecondCost = 5 * 1024 * 1024;
+static const double cDefaultEncodedByteCost = 1;
+static const double cDefaultParsedByteCost = 1;
 
 MemoryCache* memoryCache()
 {
@@ -72,6 +79,11 @@ MemoryCache::MemoryCache()
     , m_deadDecodedDataDeletionInterval(cDefaultDecodedDataDeletionInterval)
     , m_liveSize(0)
     , m_deadSize(0)
+    , m_evictionPolicy(LRUEvictionPolicy)
+    , m_decodeSecondCost(cDefaultDecodeSecondCost)
+    , m_encodedByteCost(cDefaultEncodedByteCost)
+    , m_parsedByteCost(cDefaultParsedByteCost)
+    , m_evictionInflation(0)
 {
 }
 
@@ -201,6 +213,7 @@ void MemoryCache::pruneLiveResources()
             // Destroy our decoded data. This will remove us from 
             // m_liveDecodedResources, and possibly move us to a different LRU 
             // list in m_allResources.
+            recordEviction(current, LiveDecodedDataPruned, current->decodedSize());
             current->destroyDecodedData();
 
             if (targetSize && m_liveSize <= targetSize)
@@ -231,7 +244,7 @@ void MemoryCache::pruneDeadResources()
                 if (current->wasPurged()) {
                     ASSERT(!current->hasClients());
                     ASSERT(!current->isPreloaded());
-                    evict(current);
+                    evict(current, DeadResourcePruned);
                 }
                 current = prev;
             }
@@ -239,6 +252,11 @@ void MemoryCache::pruneDeadResources()
         if (targetSize && m_deadSize <= targetSize)
             return;
     }
+
+    if (m_evictionPolicy == CostAwareEvictionPolicy) {
+        pruneDeadResourcesByCost(targetSize);
+        return;
+    }
     
     bool canShrinkLRULists = true;
     m_inPruneDeadResources = true;
@@ -253,6 +271,8 @@ void MemoryCache::pruneDeadResources()
                 // Destroy our decoded data. This will remove us from 
                 // m_liveDecodedResources, and possibly move us to a different 
                 // LRU list in m_allResources.
+                if (current->decodedSize())
+                    recordEviction(current, DeadDecodedDataPruned, current->decodedSize());
                 current->destroyDecodedData();
                 
                 if (targetSize && m_deadSize <= targetSize) {
@@ -269,7 +289,7 @@ void MemoryCache::pruneDeadResources()
             CachedResource* prev = current->m_prevInAllResourcesList;
             if (!current->hasClients() && !current->isPreloaded() && !current->isCacheValidator()) {
                 if (!makeResourcePurgeable(current))
-                    evict(current);
+                    evict(current, DeadResourcePruned);
 
                 // If evict() caused pruneDeadResources() to be re-entered, bail out. This can happen when removing an
                 // SVG CachedImage that has subresources.
@@ -294,6 +314,98 @@ void MemoryCache::pruneDeadResources()
     m_inPruneDeadResources = false;
 }
 
+static bool lowerEvictionPriority(const pair<double, CachedResource*>& a, const pair<double, CachedResource*>& b)
+{
+    return a.first < b.first;
+}
+
+void MemoryCache::collectDeadResourcesByEvictionPriority(Vector<CachedResource*>& resources)
+{
+    Vector<pair<double, CachedResource*> > candidates;
+    int size = m_allResources.size();
+    for (int i = 0; i < size; i++) {
+        for (CachedResource* current = m_allResources[i].m_head; current; current = current->m_nextInAllResourcesList) {
+            if (!current->hasClients() && !current->isPreloaded())
+                candidates.append(make_pair(evictionPriority(current), current));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), lowerEvictionPriority);
+
+    resources.reserveCapacity(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i)
+        resources.append(candidates[i].second);
+}
+
+void MemoryCache::pruneDeadResourcesByCost(unsigned targetSize)
+{
+    m_inPruneDeadResources = true;
+
+    // Decoded data can be rebuilt without going back to the network, so all
+    // of it goes before any resource is evicted, cheapest first.
+    Vector<CachedResource*> candidates;
+    collectDeadResourcesByEvictionPriority(candidates);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        CachedResource* current = candidates[i];
+        if (!current->isLoaded() || !current->decodedSize())
+            continue;
+        recordEviction(current, DeadDecodedDataPruned, current->decodedSize());
+        current->destroyDecodedData();
+        if (targetSize && m_deadSize <= targetSize) {
+            m_inPruneDeadResources = false;
+            return;
+        }
+    }
+
+    // Dropping decoded data changed the sizes and so the priorities.
+    candidates.clear();
+    collectDeadResourcesByEvictionPriority(candidates);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        CachedResource* current = candidates[i];
+        if (current->isCacheValidator())
+            continue;
+        m_evictionInflation = max(m_evictionInflation, evictionPriority(current));
+        if (!makeResourcePurgeable(current))
+            evict(current, DeadResourcePruned);
+
+        // If evict() caused pruneDeadResources() to be re-entered, the
+        // remaining candidates may be gone.
+        if (!m_inPruneDeadResources)
+            return;
+
+        if (targetSize && m_deadSize <= targetSize)
+            break;
+    }
+    m_inPruneDeadResources = false;
+}
+
+double MemoryCache::evictionCost(CachedResource* resource) const
+{
+    double cost = resource->decodeTime() * m_decodeSecondCost + resource->encodedSize() * m_encodedByteCost;
+    switch (resource->type()) {
+    case CachedResource::CSSStyleSheet:
+    case CachedResource::Script:
+    case CachedResource::FontResource:
+#if ENABLE(XSLT)
+    case CachedResource::XSLStyleSheet:
+#endif
+        cost += resource->encodedSize() * m_parsedByteCost;
+        break;
+    default:
+        break;
+    }
+    return cost;
+}
+
+double MemoryCache::evictionPriority(CachedResource* resource) const
+{
+    // GreedyDual-Size with frequency: the cost of bringing the resource back
+    // for each byte it frees, weighted by how often it was used, on top of
+    // the inflation at the time it was last used.
+    unsigned size = max(resource->size(), 1U);
+    unsigned accessCount = max(resource->accessCount(), 1U);
+    return resource->m_evictionBase + accessCount * evictionCost(resource) / size;
+}
+
 void MemoryCache::setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes)
 {
     ASSERT(minDeadBytes <= maxDeadBytes);
@@ -304,6 +416,13 @@ void MemoryCache::setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, un
     prune();
 }
 
+void MemoryCache::setEvictionCostWeights(double decodeSecond, double encodedByte, double parsedByte)
+{
+    m_decodeSecondCost = decodeSecond > 0 ? decodeSecond : cDefaultDecodeSecondCost;
+    m_encodedByteCost = encodedByte > 0 ? encodedByte : cDefaultEncodedByteCost;
+    m_parsedByteCost = parsedByte > 0 ? parsedByte : cDefaultParsedByteCost;
+}
+
 bool MemoryCache::makeResourcePurgeable(CachedResource* resource)
 {
     if (!MemoryCache::shouldMakeResourcePurgeableOnEviction())
@@ -326,12 +445,14 @@ bool MemoryCache::makeResourcePurgeable(CachedResource* resource)
     return true;
 }
 
-void MemoryCache::evict(CachedResource* resource)
+void MemoryCache::evict(CachedResource* resource, EvictionReason reason)
 {
     LOG(ResourceLoading, "Evicting resource %p for '%s' from cache", resource, resource->url().string().latin1().data());
     // The resource may have already been removed by someone other than our caller,
     // who needed a fresh copy for a reload. See <http://bugs.webkit.org/show_bug.cgi?id=12479#c6>.
     if (resource->inCache()) {
+        recordEviction(resource, reason, resource->size());
+
         // Remove from the resource map.
         m_resources.remove(resource->url());
         resource->setInCache(false);
@@ -475,6 +596,7 @@ void MemoryCache::resourceAccessed(CachedResource* resource)
     
     // Add to our access count.
     resource->increaseAccessCount();
+    resource->m_evictionBase = m_evictionInflation;
     
     // Now insert into the new queue.
     insertInLRUList(resource);
@@ -608,34 +730,60 @@ void MemoryCache::TypeStatistic::addResource(CachedResource* o)
     purgedSize += purged ? pageSize : 0;
 }
 
+static MemoryCache::TypeStatistic* typeStatistic(MemoryCache::Statistics& stats, CachedResource::Type type)
+{
+    switch (type) {
+    case CachedResource::ImageResource:
+        return &stats.images;
+    case CachedResource::CSSStyleSheet:
+        return &stats.cssStyleSheets;
+    case CachedResource::Script:
+        return &stats.scripts;
+#if ENABLE(XSLT)
+    case CachedResource::XSLStyleSheet:
+        return &stats.xslStyleSheets;
+#endif
+    case CachedResource::FontResource:
+        return &stats.fonts;
+    default:
+        return 0;
+    }
+}
+
+static void copyEvictions(MemoryCache::TypeStatistic& to, const MemoryCache::TypeStatistic& from)
+{
+    for (int i = 0; i < MemoryCache::NumberOfEvictionReasons; ++i) {
+        to.evictions[i] = from.evictions[i];
+        to.evictedSize[i] = from.evictedSize[i];
+    }
+}
+
+void MemoryCache::recordEviction(CachedResource* resource, EvictionReason reason, unsigned size)
+{
+    TypeStatistic* stats = typeStatistic(m_evictionStatistics, resource->type());
+    if (!stats)
+        return;
+    stats->evictions[reason]++;
+    stats->evictedSize[reason] += size;
+}
+
 MemoryCache::Statistics MemoryCache::getStatistics()
 {
     Statistics stats;
     CachedResourceMap::iterator e = m_resources.end();
     for (CachedResourceMap::iterator i = m_resources.begin(); i != e; ++i) {
         CachedResource* resource = i->second;
-        switch (resource->type()) {
-        case CachedResource::ImageResource:
-            stats.images.addResource(resource);
-            break;
-        case CachedResource::CSSStyleSheet:
-            stats.cssStyleSheets.addResource(resource);
-            break;
-        case CachedResource::Script:
-            stats.scripts.addResource(resource);
-            break;
+        if (TypeStatistic* typeStats = typeStatistic(stats, resource->type()))
+            typeStats->addResource(resource);
+    }
+
+    copyEvictions(stats.images, m_evictionStatistics.images);
+    copyEvictions(stats.cssStyleSheets, m_evictionStatistics.cssStyleSheets);
+    copyEvictions(stats.scripts, m_evictionStatistics.scripts);
 #if ENABLE(XSLT)
-        case CachedResource::XSLStyleSheet:
-            stats.xslStyleSheets.addResource(resource);
-            break;
+    copyEvictions(stats.xslStyleSheets, m_evictionStatistics.xslStyleSheets);
 #endif
-        case CachedResource::FontResource:
-            stats.fonts.addResource(resource);
-            break;
-        default:
-            break;
-        }
-    }
+    copyEvictions(stats.fonts, m_evictionStatistics.fonts);
     return stats;
 }
 
@@ -666,6 +814,39 @@ void MemoryCache::evictResources()
     setDisabled(false);
 }
 
+unsigned MemoryCache::destroyDeadDecodedData()
+{
+    unsigned freed = 0;
+    int size = m_allResources.size();
+    for (int i = size - 1; i >= 0; i--) {
+        CachedResource* current = m_allResources[i].m_tail;
+        while (current) {
+            // Destroying the decoded data may move the resource to another list.
+            CachedResource* prev = current->m_prevInAllResourcesList;
+            if (!current->hasClients() && !current->isPreloaded() && current->isLoaded() && current->decodedSize()) {
+                freed += current->decodedSize();
+                recordEviction(current, DeadDecodedDataPruned, current->decodedSize());
+                current->destroyDecodedData();
+            }
+            current = prev;
+        }
+    }
+    return freed;
+}
+
+unsigned MemoryCache::evictDeadResources()
+{
+    unsigned deadSize = m_deadSize;
+
+    // With no room for dead resources, pruneDeadResources() evicts all it can.
+    unsigned maxDeadCapacity = m_maxDeadCapacity;
+    m_maxDeadCapacity = 0;
+    pruneDeadResources();
+    m_maxDeadCapacity = maxDeadCapacity;
+
+    return deadSize - min(deadSize, m_deadSize);
+}
+
 #ifndef NDEBUG
 void MemoryCache::dumpStats()
 {
@@ -680,6 +861,18 @@ void MemoryCache::dumpStats()
     printf("%-13s %13d %13d %13d %13d %13d %13d\n", "JavaScript", s.scripts.count, s.scripts.size, s.scripts.liveSize, s.scripts.decodedSize, s.scripts.purgeableSize, s.scripts.purgedSize);
     printf("%-13s %13d %13d %13d %13d %13d %13d\n", "Fonts", s.fonts.count, s.fonts.size, s.fonts.liveSize, s.fonts.decodedSize, s.fonts.purgeableSize, s.fonts.purgedSize);
     printf("%-13s %-13s %-13s %-13s %-13s %-13s %-13s\n\n", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------", "-------------");
+
+    printf("Evictions (count/bytes):\n");
+    printf("%-13s %-21s %-21s %-21s %-21s\n", "", "LiveDecoded", "DeadDecoded", "Dead", "Removed");
+    const char* names[] = { "Images", "CSS", "JavaScript", "Fonts" };
+    const TypeStatistic* types[] = { &s.images, &s.cssStyleSheets, &s.scripts, &s.fonts };
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); ++i) {
+        printf("%-13s", names[i]);
+        for (int reason = 0; reason < NumberOfEvictionReasons; ++reason)
+            printf(" %8d/%-12d", types[i]->evictions[reason], types[i]->evictedSize[reason]);
+        printf("\n");
+    }
+    printf("\n");
 }
 
 void MemoryCache::dumpLRULists(bool includeLive) const
@@ -85,6 +85,23 @@ public:
         LRUList() : m_head(0), m_tail(0) { }
     };
 
+    enum EvictionPolicy {
+        // Dead resources are evicted from the LRU lists, which are ordered by
+        // size divided by access count.
+        LRUEvictionPolicy,
+        // Dead resources are evicted in order of what it would cost to bring
+        // them back for each byte they free (GreedyDual-Size with frequency).
+        CostAwareEvictionPolicy
+    };
+
+    enum EvictionReason {
+        LiveDecodedDataPruned, // Decoded data of a resource still used by a page was destroyed.
+        DeadDecodedDataPruned, // Decoded data of a resource no page uses was destroyed.
+        DeadResourcePruned, // A resource no page uses was evicted to make room.
+        ResourceRemoved, // A resource was removed explicitly, or the whole cache was cleared.
+        NumberOfEvictionReasons
+    };
+
     struct TypeStatistic {
         int count;
         int size;
@@ -92,7 +109,15 @@ public:
         int decodedSize;
         int purgeableSize;
         int purgedSize;
-        TypeStatistic() : count(0), size(0), liveSize(0), decodedSize(0), purgeableSize(0), purgedSize(0) { }
+        // Totals since the cache was created.
+        int evictions[NumberOfEvictionReasons];
+        int evictedSize[NumberOfEvictionReasons];
+        TypeStatistic()
+            : count(0), size(0), liveSize(0), decodedSize(0), purgeableSize(0), purgedSize(0)
+        {
+            for (int i = 0; i < NumberOfEvictionReasons; ++i)
+                evictions[i] = evictedSize[i] = 0;
+        }
         void addResource(CachedResource*);
     };
     
@@ -123,12 +148,30 @@ public:
     //  - totalBytes: The maximum number of bytes that the cache should consume overall.
     void setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes);
 
+    void setEvictionPolicy(EvictionPolicy policy) { m_evictionPolicy = policy; }
+    EvictionPolicy evictionPolicy() const { return m_evictionPolicy; }
+
+    // Weights of the CostAwareEvictionPolicy cost model, in bytes:
+    //  - decodeSecond: one second spent decoding an image.
+    //  - encodedByte: one encoded byte that has to be read again from the network or the disk cache.
+    //  - parsedByte: one encoded byte of a stylesheet, script or font that has to be parsed again.
+    // A weight that is not positive is set back to its default.
+    void setEvictionCostWeights(double decodeSecond, double encodedByte, double parsedByte);
+
     // Turn the cache on and off.  Disabling the cache will remove all resources from the cache.  They may
     // still live on if they are referenced by some Web page though.
     void setDisabled(bool);
     bool disabled() const { return m_disabled; }
 
     void evictResources();
+
+    // Destroys the decoded data of every resource that no page uses, and
+    // returns the number of bytes freed.
+    unsigned destroyDeadDecodedData();
+
+    // Evicts every resource that no page uses, unlike evictResources(), and
+    // returns the number of bytes freed.
+    unsigned evictDeadResources();
     
     void setPruneEnabled(bool enabled) { m_pruneEnabled = enabled; }
     void prune()
@@ -171,7 +214,7 @@ public:
     void removeResourcesWithOrigin(SecurityOrigin*);
     void getOriginsWithCache(SecurityOriginSet& origins);
 
-#ifdef ANDROID_INSTRUMENT
+#if PLATFORM(ANDROID)
     unsigned getLiveSize() { return m_liveSize; }
     unsigned getDeadSize() { return m_deadSize; }
 #endif
@@ -193,8 +236,14 @@ private:
     void pruneDeadResources(); // Flush decoded and encoded data from resources not referenced by Web pages.
     void pruneLiveResources(); // Flush decoded data from resources still referenced by Web pages.
 
+    void pruneDeadResourcesByCost(unsigned targetSize);
+    void collectDeadResourcesByEvictionPriority(Vector<CachedResource*>&);
+    double evictionCost(CachedResource*) const;
+    double evictionPriority(CachedResource*) const;
+    void recordEviction(CachedResource*, EvictionReason, unsigned size);
+
     bool makeResourcePurgeable(CachedResource*);
-    void evict(CachedResource*);
+    void evict(CachedResource*, EvictionReason = ResourceRemoved);
 
     bool m_disabled;  // Whether or not the cache is enabled.
     bool m_pruneEnabled;
@@ -219,6 +268,18 @@ private:
     // A URL-based map of all resources that are in the cache (including the freshest version of objects that are currently being 
     // referenced by a Web page).
     HashMap<String, CachedResource*> m_resources;
+
+    EvictionPolicy m_evictionPolicy;
+    double m_decodeSecondCost;
+    double m_encodedByteCost;
+    double m_parsedByteCost;
+    // The "L" of GreedyDual-Size: the priority of the last resource evicted by
+    // cost. Resources accessed later start from it, so that resources that
+    // are not used again eventually lose to newer ones.
+    double m_evictionInflation;
+
+    // Only the eviction counts are used.
+    Statistics m_evictionStatistics;
 };
 
 inline bool MemoryCache::shouldMakeResourcePurgeableOnEviction()
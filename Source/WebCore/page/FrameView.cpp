@@ -971,7 +971,16 @@ void FrameView::layout(bool allowSubtree)
         
     m_inLayout = true;
     beginDeferredRepaints();
+#ifdef ANDROID_INSTRUMENT
+    LayoutProfiler::willLayout(root, subtree);
+    {
+        LayoutProfiler::Scope profilerScope(root);
+        root->layout();
+    }
+    LayoutProfiler::didLayout();
+#else
     root->layout();
+#endif
     endDeferredRepaints();
     m_inLayout = false;
 
@@ -1853,8 +1862,12 @@ void FrameView::setNeedsLayout()
         return;
     }
     RenderView* root = m_frame->contentRenderer();
-    if (root)
+    if (root) {
+#ifdef ANDROID_INSTRUMENT
+        LayoutProfiler::CauseScope layoutCause(LayoutProfiler::ViewChange);
+#endif
         root->setNeedsLayout(true);
+    }
 }
 
 void FrameView::unscheduleRelayout()
@@ -57,19 +57,50 @@ static inline void freeSegment(char* p)
     fastFree(p);
 }
 
+#if PLATFORM(ANDROID)
+// Holds data appended after external segments, so that it stays in order.
+class VectorSegment : public SharedBufferSegment {
+public:
+    static PassRefPtr<VectorSegment> create(const char* data, unsigned length)
+    {
+        return adoptRef(new VectorSegment(data, length));
+    }
+
+    virtual const char* data() const { return m_data.data(); }
+    virtual unsigned size() const { return m_data.size(); }
+
+private:
+    VectorSegment(const char* data, unsigned length)
+    {
+        m_data.append(data, length);
+    }
+
+    Vector<char> m_data;
+};
+#endif
+
 SharedBuffer::SharedBuffer()
     : m_size(0)
+#if PLATFORM(ANDROID)
+    , m_externalSize(0)
+#endif
 {
 }
 
 SharedBuffer::SharedBuffer(const char* data, int size)
     : m_size(0)
+#if PLATFORM(ANDROID)
+    , m_externalSize(0)
+#endif
 {
     append(data, size);
 }
 
 SharedBuffer::SharedBuffer(const unsigned char* data, int size)
     : m_size(0)
+#if PLATFORM(ANDROID)
+    , m_externalSize(0)
+#endif
 {
     append(reinterpret_cast<const char*>(data), size);
 }
@@ -122,6 +153,13 @@ void SharedBuffer::append(const char* data, unsigned length)
     ASSERT(!m_purgeableBuffer);
 
     maybeTransferPlatformData();
+
+#if PLATFORM(ANDROID)
+    if (!m_externalSegments.isEmpty()) {
+        append(VectorSegment::create(data, length));
+        return;
+    }
+#endif
     
     unsigned positionInSegment = offsetInSegment(m_size - m_buffer.size());
     m_size += length;
@@ -155,6 +193,47 @@ void SharedBuffer::append(const char* data, unsigned length)
     }
 }
 
+#if PLATFORM(ANDROID)
+void SharedBuffer::append(PassRefPtr<SharedBufferSegment> segment)
+{
+    ASSERT(!m_purgeableBuffer);
+    unsigned length = segment->size();
+    if (!length)
+        return;
+    m_externalSegments.append(segment);
+    m_externalSize += length;
+    m_size += length;
+}
+
+void SharedBuffer::copyExternalSegmentsAndClear(char* destination, unsigned bytesToCopy) const
+{
+    unsigned bytesLeft = bytesToCopy;
+    for (unsigned i = 0; i < m_externalSegments.size(); ++i) {
+        unsigned length = m_externalSegments[i]->size();
+        ASSERT(bytesLeft >= length);
+        memcpy(destination, m_externalSegments[i]->data(), length);
+        destination += length;
+        bytesLeft -= length;
+    }
+    m_externalSegments.clear();
+    m_externalSize = 0;
+}
+
+unsigned SharedBuffer::getSomeExternalData(const char*& someData, unsigned position) const
+{
+    for (unsigned i = 0; i < m_externalSegments.size(); ++i) {
+        unsigned length = m_externalSegments[i]->size();
+        if (position < length) {
+            someData = m_externalSegments[i]->data() + position;
+            return length - position;
+        }
+        position -= length;
+    }
+    someData = 0;
+    return 0;
+}
+#endif
+
 void SharedBuffer::clear()
 {
     clearPlatformData();
@@ -170,6 +249,10 @@ void SharedBuffer::clear()
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
     m_dataArray.clear();
 #endif
+#if PLATFORM(ANDROID)
+    m_externalSegments.clear();
+    m_externalSize = 0;
+#endif
 }
 
 PassRefPtr<SharedBuffer> SharedBuffer::copy() const
@@ -183,8 +266,20 @@ PassRefPtr<SharedBuffer> SharedBuffer::copy() const
     clone->m_size = m_size;
     clone->m_buffer.reserveCapacity(m_size);
     clone->m_buffer.append(m_buffer.data(), m_buffer.size());
+#if PLATFORM(ANDROID)
+    // The last segment is only partly used, and the external segments follow it.
+    unsigned bytesLeft = m_size - m_buffer.size() - m_externalSize;
+    for (unsigned i = 0; i < m_segments.size(); ++i) {
+        unsigned bytesToCopy = min(bytesLeft, segmentSize);
+        clone->m_buffer.append(m_segments[i], bytesToCopy);
+        bytesLeft -= bytesToCopy;
+    }
+    for (unsigned i = 0; i < m_externalSegments.size(); ++i)
+        clone->m_buffer.append(m_externalSegments[i]->data(), m_externalSegments[i]->size());
+#else
     for (unsigned i = 0; i < m_segments.size(); ++i)
         clone->m_buffer.append(m_segments[i], segmentSize);
+#endif
     return clone;
 }
 
@@ -201,6 +296,10 @@ const Vector<char>& SharedBuffer::buffer() const
         m_buffer.resize(m_size);
         char* destination = m_buffer.data() + bufferSize;
         unsigned bytesLeft = m_size - bufferSize;
+#if PLATFORM(ANDROID)
+        unsigned externalBytes = m_externalSize;
+        bytesLeft -= externalBytes;
+#endif
         for (unsigned i = 0; i < m_segments.size(); ++i) {
             unsigned bytesToCopy = min(bytesLeft, segmentSize);
             memcpy(destination, m_segments[i], bytesToCopy);
@@ -211,6 +310,9 @@ const Vector<char>& SharedBuffer::buffer() const
         m_segments.clear();
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
         copyDataArrayAndClear(destination, bytesLeft);
+#endif
+#if PLATFORM(ANDROID)
+        copyExternalSegmentsAndClear(destination, externalBytes);
 #endif
     }
     return m_buffer;
@@ -236,6 +338,11 @@ unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) con
  
     position -= consecutiveSize;
     unsigned segmentedSize = m_size - consecutiveSize;
+#if PLATFORM(ANDROID)
+    segmentedSize -= m_externalSize;
+    if (position >= segmentedSize)
+        return getSomeExternalData(someData, position - segmentedSize);
+#endif
     unsigned segments = m_segments.size();
     unsigned segment = segmentIndex(position);
     ASSERT(segment < segments);
@@ -49,6 +49,17 @@ namespace WebCore {
     
 class PurgeableBuffer;
 
+#if PLATFORM(ANDROID)
+// Memory owned by someone else, such as a network buffer, that a SharedBuffer
+// can hold on to instead of copying it.
+class SharedBufferSegment : public RefCounted<SharedBufferSegment> {
+public:
+    virtual ~SharedBufferSegment() { }
+    virtual const char* data() const = 0;
+    virtual unsigned size() const = 0;
+};
+#endif
+
 class SharedBuffer : public RefCounted<SharedBuffer> {
 public:
     static PassRefPtr<SharedBuffer> create() { return adoptRef(new SharedBuffer); }
@@ -100,6 +111,11 @@ public:
 #if HAVE(CFNETWORK_DATA_ARRAY_CALLBACK)
     void append(CFDataRef);
 #endif
+#if PLATFORM(ANDROID)
+    // Keeps a reference to the segment rather than copying it. Segments are
+    // only copied if data() needs the whole buffer in one piece.
+    void append(PassRefPtr<SharedBufferSegment>);
+#endif
 
     PassRefPtr<SharedBuffer> copy() const;
     
@@ -146,6 +162,13 @@ private:
     mutable Vector<RetainPtr<CFDataRef> > m_dataArray;
     void copyDataArrayAndClear(char *destination, unsigned bytesToCopy) const;
 #endif
+#if PLATFORM(ANDROID)
+    // Always come after m_buffer and m_segments.
+    mutable Vector<RefPtr<SharedBufferSegment> > m_externalSegments;
+    mutable unsigned m_externalSize;
+    void copyExternalSegmentsAndClear(char* destination, unsigned bytesToCopy) const;
+    unsigned getSomeExternalData(const char*& data, unsigned position) const;
+#endif
 #if USE(CF)
     SharedBuffer(CFDataRef);
     RetainPtr<CFDataRef> m_cfData;
@@ -107,6 +107,8 @@ public:
     static void setCookies(const Document*, const KURL&, const String& value);
     static String cookies(const Document*, const KURL&);
     static bool cookiesEnabled(const Document*);
+    // DNS
+    static void prefetchDNS(const String& hostname);
     // Plugin
     static NPObject* pluginScriptableObject(Widget*);
     // Popups
@@ -414,11 +414,6 @@ char* dirname(const char*)
 
     // new as of SVN change 38068, Nov 5, 2008
 namespace WebCore {
-void prefetchDNS(const String&)
-{
-    notImplemented();
-}
-
 PassRefPtr<Icon> Icon::createIconForFiles(const Vector<String>&)
 {
     notImplemented();
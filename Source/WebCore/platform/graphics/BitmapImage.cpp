@@ -124,7 +124,10 @@ void BitmapImage::cacheFrame(size_t index)
     if (m_frames.size() < numFrames)
         m_frames.grow(numFrames);
 
+    double decodeStartTime = currentTime();
     m_frames[index].m_frame = m_source.createFrameAtIndex(index);
+    if (imageObserver())
+        imageObserver()->didDecode(this, currentTime() - decodeStartTime);
     if (numFrames == 1 && m_frames[index].m_frame)
         checkForSolidColor();
 
@@ -201,7 +204,12 @@ bool BitmapImage::dataChanged(bool allDataReceived)
     
     // Feed all the data we've seen so far to the image decoder.
     m_allDataReceived = allDataReceived;
+    // Some decoders, like the Android one, decode as soon as they are given
+    // the data rather than when a frame is asked for.
+    double decodeStartTime = currentTime();
     m_source.setData(data(), allDataReceived);
+    if (imageObserver())
+        imageObserver()->didDecode(this, currentTime() - decodeStartTime);
     
     // Clear the frame count.
     m_haveFrameCount = false;
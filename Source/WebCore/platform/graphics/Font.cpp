@@ -177,12 +177,41 @@ float Font::width(const TextRun& run, HashSet<const SimpleFontData*>* fallbackFo
         // If the complex text implementation cannot return fallback fonts, avoid
         // returning them for simple text as well.
         static bool returnFallbackFonts = canReturnFallbackFontsForComplexText();
-        return floatWidthForSimpleText(run, 0, returnFallbackFonts ? fallbackFonts : 0, codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds) ? glyphOverflow : 0);
+        GlyphOverflow* glyphOverflowToUse = codePathToUse == SimpleWithGlyphOverflow || (glyphOverflow && glyphOverflow->computeBounds) ? glyphOverflow : 0;
+        HashSet<const SimpleFontData*>* fallbackFontsToUse = returnFallbackFonts ? fallbackFonts : 0;
+
+        // The cache only knows the width, so callers that also want the glyph
+        // overflow or the fallback fonts always measure the run.
+        bool useWidthCache = !glyphOverflowToUse && !fallbackFontsToUse && canUseWidthCache(run);
+        float width;
+        if (useWidthCache && m_fontList->widthCache().get(run, width))
+            return width;
+
+        width = floatWidthForSimpleText(run, 0, fallbackFontsToUse, glyphOverflowToUse);
+        if (useWidthCache)
+            m_fontList->widthCache().add(run, width);
+        return width;
     }
 
     return floatWidthForComplexText(run, fallbackFonts, glyphOverflow);
 }
 
+bool Font::canUseWidthCache(const TextRun& run) const
+{
+    // The cached width depends only on the characters and the fonts, so skip
+    // runs whose width also depends on their position, justification or the
+    // spacing of this particular Font (Fonts sharing a FontFallbackList may
+    // have different spacing). Widths measured while web fonts are still
+    // loading are placeholders and must not be remembered either.
+    if (run.allowTabs() || run.expansion())
+        return false;
+#if ENABLE(SVG)
+    if (run.horizontalGlyphStretch() != 1)
+        return false;
+#endif
+    return !wordSpacing() && !letterSpacing() && !typesettingFeatures() && !loadingCustomFonts();
+}
+
 float Font::width(const TextRun& run, int extraCharsAvailable, int& charsConsumed, String& glyphName) const
 {
 #if !ENABLE(SVG_FONTS)
@@ -35,6 +35,11 @@
 
 namespace WebCore {
 
+#ifdef ANDROID_INSTRUMENT
+unsigned WidthCache::s_totalHits = 0;
+unsigned WidthCache::s_totalMisses = 0;
+#endif
+
 FontFallbackList::FontFallbackList()
     : m_pageZero(0)
     , m_cachedPrimarySimpleFontData(0)
@@ -56,6 +61,7 @@ void FontFallbackList::invalidate(PassRefPtr<FontSelector> fontSelector)
     m_familyIndex = 0;    
     m_pitch = UnknownPitch;
     m_loadingCustomFonts = false;
+    m_widthCache.clear();
     m_fontSelector = fontSelector;
     m_generation = fontCache()->generation();
 }
@@ -23,6 +23,7 @@
 
 #include "FontSelector.h"
 #include "SimpleFontData.h"
+#include "WidthCache.h"
 #include <wtf/Forward.h>
 
 namespace WebCore {
@@ -52,6 +53,8 @@ public:
     FontSelector* fontSelector() const { return m_fontSelector.get(); }
     unsigned generation() const { return m_generation; }
 
+    WidthCache& widthCache() const { return m_widthCache; }
+
 private:
     FontFallbackList();
 
@@ -78,6 +81,7 @@ private:
     mutable int m_familyIndex;
     mutable Pitch m_pitch;
     mutable bool m_loadingCustomFonts;
+    mutable WidthCache m_widthCache;
     unsigned m_generation;
 
     friend class Font;
@@ -38,6 +38,8 @@ protected:
     virtual ~ImageObserver() {}
 public:
     virtual void decodedSizeChanged(const Image*, int delta) = 0;
+    // Called with the time taken by each call into the decoder.
+    virtual void didDecode(const Image*, double decodeTime) = 0;
     virtual void didDraw(const Image*) = 0;
 
     virtual bool shouldPauseAnimation(const Image*) = 0;
@@ -0,0 +1,182 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WidthCache_h
+#define WidthCache_h
+
+#include "TextRun.h"
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/StringHasher.h>
+
+namespace WebCore {
+
+// Remembers the measured width of short runs of text for one FontFallbackList.
+// Line layout measures the same words again and again while it looks for break
+// opportunities and on every relayout, so a hit here saves walking the glyph
+// pages for each character of the word.
+//
+// Only plain runs are cached: the caller is responsible for not asking when the
+// width also depends on something other than the characters and the font (tabs,
+// justification, glyph stretching, word or letter spacing).
+class WidthCache {
+    WTF_MAKE_NONCOPYABLE(WidthCache);
+public:
+    // Longer runs are unlikely to repeat and would make every key bigger.
+    static const unsigned maxLength = 16;
+    // Keeps each cache under 100KB. When it fills up it is simply cleared;
+    // the words of the current page quickly come back.
+    static const unsigned maxEntries = 1000;
+
+    WidthCache()
+        : m_hits(0)
+        , m_misses(0)
+    {
+    }
+
+    // Returns true and sets |width| if |run| has already been measured.
+    bool get(const TextRun& run, float& width)
+    {
+        if (!isCacheable(run))
+            return false;
+
+        Map::const_iterator it = m_widths.find(Key(run.characters(), run.length(), run.rtl()));
+        if (it == m_widths.end()) {
+            ++m_misses;
+#ifdef ANDROID_INSTRUMENT
+            ++s_totalMisses;
+#endif
+            return false;
+        }
+        ++m_hits;
+#ifdef ANDROID_INSTRUMENT
+        ++s_totalHits;
+#endif
+        width = it->second;
+        return true;
+    }
+
+    void add(const TextRun& run, float width)
+    {
+        if (!isCacheable(run))
+            return;
+        if (m_widths.size() >= maxEntries)
+            m_widths.clear();
+        m_widths.set(Key(run.characters(), run.length(), run.rtl()), width);
+    }
+
+    void clear() { m_widths.clear(); }
+
+    unsigned size() const { return m_widths.size(); }
+    unsigned hits() const { return m_hits; }
+    unsigned misses() const { return m_misses; }
+
+#ifdef ANDROID_INSTRUMENT
+    // Totals over every WidthCache, for TimeCounter::report().
+    static unsigned totalHits() { return s_totalHits; }
+    static unsigned totalMisses() { return s_totalMisses; }
+#endif
+
+private:
+    static bool isCacheable(const TextRun& run)
+    {
+        return run.length() > 0 && static_cast<unsigned>(run.length()) <= maxLength;
+    }
+
+    // The characters of the run are stored inline so that a lookup never
+    // allocates. The direction is part of the key because right-to-left runs
+    // are measured with mirrored glyphs.
+    class Key {
+    public:
+        Key()
+            : m_length(emptyValueLength)
+            , m_rtl(false)
+            , m_hash(0)
+        {
+        }
+
+        Key(WTF::HashTableDeletedValueType)
+            : m_length(deletedValueLength)
+            , m_rtl(false)
+            , m_hash(0)
+        {
+        }
+
+        Key(const UChar* characters, unsigned length, bool rtl)
+            : m_length(length)
+            , m_rtl(rtl)
+            , m_hash(StringHasher::computeHash(characters, length) ^ rtl)
+        {
+            ASSERT(length <= maxLength);
+            memcpy(m_characters, characters, length * sizeof(UChar));
+        }
+
+        unsigned hash() const { return m_hash; }
+        bool isHashTableDeletedValue() const { return m_length == deletedValueLength; }
+
+        bool operator==(const Key& other) const
+        {
+            return m_hash == other.m_hash && m_length == other.m_length && m_rtl == other.m_rtl
+                && !memcmp(m_characters, other.m_characters, m_length * sizeof(UChar));
+        }
+
+    private:
+        static const unsigned emptyValueLength = maxLength + 1;
+        static const unsigned deletedValueLength = maxLength + 2;
+
+        UChar m_characters[maxLength];
+        unsigned m_length;
+        bool m_rtl;
+        unsigned m_hash;
+    };
+
+    struct KeyHash {
+        static unsigned hash(const Key& key) { return key.hash(); }
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        // The empty and deleted values have lengths no real key can have, so
+        // comparing against them is safe.
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+
+    struct KeyTraits : WTF::SimpleClassHashTraits<Key> {
+        static const bool emptyValueIsZero = false;
+        static Key emptyValue() { return Key(); }
+    };
+
+    typedef HashMap<Key, float, KeyHash, KeyTraits> Map;
+
+    Map m_widths;
+    unsigned m_hits;
+    unsigned m_misses;
+
+#ifdef ANDROID_INSTRUMENT
+    static unsigned s_totalHits;
+    static unsigned s_totalMisses;
+#endif
+};
+
+} // namespace WebCore
+
+#endif // WidthCache_h
@@ -36,6 +36,7 @@
 #include "SkBitmapRef.h"
 #include "SkCanvas.h"
 #include "SkDevice.h"
+#include "SkGraphics.h"
 #include "SkPicture.h"
 #include "TilesManager.h"
 
@@ -110,6 +111,19 @@ void BaseRenderer::drawTileInfo(SkCanvas* canvas,
     canvas->drawText(str, strlen(str), 0, textY, paint);
     paint.setARGB(255, 255, 0, 0);
     canvas->drawText(str, strlen(str), 0, textY + 1, paint);
+
+    unsigned tiles = 0;
+    unsigned missedTiles = 0;
+    size_t rasterizedBytes = 0;
+    TilesManager::instance()->getGlyphCacheStats(&tiles, &missedTiles, &rasterizedBytes);
+    snprintf(str, 256, "glyphs: %dKB, hits %u/%u tiles, %dKB rasterized",
+             static_cast<int>(SkGraphics::GetFontCacheUsed() / 1024), tiles - missedTiles, tiles,
+             static_cast<int>(rasterizedBytes / 1024));
+    paint.setARGB(255, 0, 0, 0);
+    textY += 12;
+    canvas->drawText(str, strlen(str), 0, textY, paint);
+    paint.setARGB(255, 255, 0, 0);
+    canvas->drawText(str, strlen(str), 0, textY + 1, paint);
 }
 
 int BaseRenderer::renderTiledContent(const TileRenderInfo& renderInfo)
@@ -132,7 +146,9 @@ int BaseRenderer::renderTiledContent(const TileRenderInfo& renderInfo)
     canvas.translate(-renderInfo.x * tileSize.width(), -renderInfo.y * tileSize.height());
     canvas.scale(renderInfo.scale, renderInfo.scale);
     unsigned int pictureCount = 0;
+    size_t glyphCacheBytes = SkGraphics::GetFontCacheUsed();
     renderInfo.tilePainter->paint(renderInfo.baseTile, &canvas, &pictureCount);
+    TilesManager::instance()->didPaintTile(glyphCacheBytes, SkGraphics::GetFontCacheUsed());
 
     if (visualIndicator) {
         canvas.restore();
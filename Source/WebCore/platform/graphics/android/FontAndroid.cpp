@@ -52,6 +52,7 @@
 #include <wtf/OwnPtr.h>
 #include <wtf/PassOwnArrayPtr.h>
 #include <wtf/PassOwnPtr.h>
+#include <wtf/StdLibExtras.h>
 #include <wtf/unicode/Unicode.h>
 #endif
 
@@ -363,6 +364,153 @@ static int truncateFixedPointToInteger(HB_Fixed value)
     return value >> 6;
 }
 
+// Identifies a script run that has been shaped: the characters of the run,
+// the code units just outside it, the font it was shaped with, its Harfbuzz
+// script and its direction. HB_ShapeItem() reads the neighbouring characters
+// to pick joining forms, so the same run shapes differently in a different
+// context. Word and letter spacing and justification padding are applied
+// after shaping (see TextRunWalker::setGlyphXPositions) so they are
+// deliberately not part of the key.
+struct ShapingCacheKey {
+    ShapingCacheKey()
+        : before(0)
+        , after(0)
+        , script(HB_Script_Common)
+        , rtl(false)
+    {
+    }
+
+    ShapingCacheKey(const UChar* characters, unsigned length, UChar before, UChar after,
+                    const FontPlatformData& platformData, HB_Script script, bool rtl)
+        : text(characters, length)
+        , before(before)
+        , after(after)
+        , font(platformData)
+        , script(script)
+        , rtl(rtl)
+    {
+    }
+
+    ShapingCacheKey(WTF::HashTableDeletedValueType)
+        : text(WTF::HashTableDeletedValue)
+        , before(0)
+        , after(0)
+        , script(HB_Script_Common)
+        , rtl(false)
+    {
+    }
+
+    bool isHashTableDeletedValue() const { return text.isHashTableDeletedValue(); }
+
+    String text;
+    UChar before;
+    UChar after;
+    FontPlatformData font;
+    HB_Script script;
+    bool rtl;
+};
+
+struct ShapingCacheKeyHash {
+    static unsigned hash(const ShapingCacheKey& key)
+    {
+        unsigned hash = WTF::intHash((static_cast<uint64_t>(key.text.impl()->hash()) << 32) | key.font.hash());
+        hash = WTF::intHash((static_cast<uint64_t>(hash) << 32) | (key.before << 16) | key.after);
+        return WTF::intHash((static_cast<uint64_t>(hash) << 32) | (key.script << 1) | key.rtl);
+    }
+
+    static bool equal(const ShapingCacheKey& a, const ShapingCacheKey& b)
+    {
+        return a.script == b.script && a.rtl == b.rtl && a.before == b.before && a.after == b.after
+            && a.font == b.font && a.text == b.text;
+    }
+
+    static const bool safeToCompareToEmptyOrDeleted = false;
+};
+
+struct ShapingCacheKeyTraits : WTF::SimpleClassHashTraits<ShapingCacheKey> {
+    // FontPlatformData keeps an allocation count, so empty buckets have to
+    // go through its constructor rather than being zero filled.
+    static const bool emptyValueIsZero = false;
+};
+
+// The raw output of HB_ShapeItem() for one script run.
+struct ShapedRun {
+    Vector<HB_Glyph> glyphs;
+    Vector<HB_GlyphAttributes> attributes;
+    Vector<HB_Fixed> advances;
+    Vector<HB_FixedPoint> offsets;
+    Vector<unsigned short> logClusters;
+
+    size_t sizeInBytes() const
+    {
+        return sizeof(ShapedRun)
+            + glyphs.size() * (sizeof(HB_Glyph) + sizeof(HB_GlyphAttributes) + sizeof(HB_Fixed) + sizeof(HB_FixedPoint))
+            + logClusters.size() * sizeof(unsigned short);
+    }
+};
+
+// Shaping is the most expensive step in measuring and drawing complex text,
+// and WebCore asks for the same runs many times over: once for the width
+// during layout, again for painting, and again for every hit test and
+// selection rect. ShapingCache remembers the Harfbuzz output per script run
+// so only the first of those requests has to call HB_ShapeItem().
+//
+// The cache is only touched from the WebCore thread. Once it grows past its
+// budget it is dropped wholesale, which keeps the bookkeeping trivial and
+// still serves the common case of a page repeatedly measuring and painting
+// the same text.
+class ShapingCache {
+    WTF_MAKE_NONCOPYABLE(ShapingCache);
+public:
+    // Longer runs are nearly always whole paragraphs that are unlikely to be
+    // shaped again with the same boundaries, so they are not cached.
+    static const unsigned maxRunLength = 256;
+    static const size_t maxSizeInBytes = 512 * 1024;
+
+    ShapingCache()
+        : m_sizeInBytes(0)
+    {
+    }
+
+    ~ShapingCache() { clear(); }
+
+    static bool isCacheable(unsigned length) { return length && length <= maxRunLength; }
+
+    const ShapedRun* get(const ShapingCacheKey& key) { return m_runs.get(key); }
+
+    void add(const ShapingCacheKey& key, PassOwnPtr<ShapedRun> shapedRun)
+    {
+        size_t size = shapedRun->sizeInBytes() + key.text.length() * sizeof(UChar);
+        if (m_sizeInBytes + size > maxSizeInBytes)
+            clear();
+
+        std::pair<Map::iterator, bool> result = m_runs.add(key, 0);
+        if (!result.second)
+            return;
+        result.first->second = shapedRun.leakPtr();
+        m_sizeInBytes += size;
+    }
+
+    void clear()
+    {
+        deleteAllValues(m_runs);
+        m_runs.clear();
+        m_sizeInBytes = 0;
+    }
+
+private:
+    typedef HashMap<ShapingCacheKey, ShapedRun*, ShapingCacheKeyHash, ShapingCacheKeyTraits> Map;
+
+    Map m_runs;
+    size_t m_sizeInBytes;
+};
+
+static ShapingCache& shapingCache()
+{
+    DEFINE_STATIC_LOCAL(ShapingCache, cache, ());
+    return cache;
+}
+
 // TextRunWalker walks a TextRun and presents each script run in sequence. A
 // TextRun is a sequence of code-points with the same embedding level (i.e. they
 // are all left-to-right or right-to-left). A script run is a subsequence where
@@ -472,6 +620,7 @@ private:
     void createGlyphArrays(int);
     void resetGlyphArrays();
     void shapeGlyphs();
+    void restoreShapedRun(const ShapedRun&);
     void setGlyphXPositions(bool);
 
     static void normalizeSpacesAndMirrorChars(const UChar* source, bool rtl,
@@ -795,6 +944,26 @@ void TextRunWalker::resetGlyphArrays()
 
 void TextRunWalker::shapeGlyphs()
 {
+    unsigned start = m_item.item.pos;
+    unsigned end = start + m_item.item.length;
+    UChar before = start ? m_item.string[start - 1] : 0;
+    UChar after = end < m_item.stringLength ? m_item.string[end] : 0;
+    // Joining skips over transparent characters such as combining marks, so
+    // next to one of those the context reaches further than the key does.
+    bool cacheable = ShapingCache::isCacheable(m_item.item.length)
+        && u_getIntPropertyValue(before, UCHAR_JOINING_TYPE) != U_JT_TRANSPARENT
+        && u_getIntPropertyValue(after, UCHAR_JOINING_TYPE) != U_JT_TRANSPARENT;
+    ShapingCacheKey key;
+    if (cacheable) {
+        key = ShapingCacheKey(m_item.string + start, m_item.item.length, before, after,
+                              *fontPlatformDataForScriptRun(), m_item.item.script,
+                              m_item.item.bidiLevel & 1);
+        if (const ShapedRun* shapedRun = shapingCache().get(key)) {
+            restoreShapedRun(*shapedRun);
+            return;
+        }
+    }
+
     // HB_ShapeItem() resets m_item.num_glyphs. If the previous call to
     // HB_ShapeItem() used less space than was available, the capacity of
     // the array may be larger than the current value of m_item.num_glyphs.
@@ -808,6 +977,35 @@ void TextRunWalker::shapeGlyphs()
         createGlyphArrays(m_item.num_glyphs << 1);
         resetGlyphArrays();
     }
+
+    if (!cacheable)
+        return;
+
+    OwnPtr<ShapedRun> shapedRun = adoptPtr(new ShapedRun);
+    shapedRun->glyphs.append(m_item.glyphs, m_item.num_glyphs);
+    shapedRun->attributes.append(m_item.attributes, m_item.num_glyphs);
+    shapedRun->advances.append(m_item.advances, m_item.num_glyphs);
+    shapedRun->offsets.append(m_item.offsets, m_item.num_glyphs);
+    shapedRun->logClusters.append(m_item.log_clusters, m_item.item.length);
+    shapingCache().add(key, shapedRun.release());
+}
+
+void TextRunWalker::restoreShapedRun(const ShapedRun& shapedRun)
+{
+    unsigned numGlyphs = shapedRun.glyphs.size();
+    if (numGlyphs > m_glyphsArrayCapacity) {
+        deleteGlyphArrays();
+        createGlyphArrays(numGlyphs);
+    }
+
+    m_item.num_glyphs = numGlyphs;
+    resetGlyphArrays();
+    memcpy(m_item.glyphs, shapedRun.glyphs.data(), numGlyphs * sizeof(m_item.glyphs[0]));
+    memcpy(m_item.attributes, shapedRun.attributes.data(), numGlyphs * sizeof(m_item.attributes[0]));
+    memcpy(m_item.advances, shapedRun.advances.data(), numGlyphs * sizeof(m_item.advances[0]));
+    memcpy(m_item.offsets, shapedRun.offsets.data(), numGlyphs * sizeof(m_item.offsets[0]));
+    memcpy(m_item.log_clusters, shapedRun.logClusters.data(),
+           shapedRun.logClusters.size() * sizeof(m_item.log_clusters[0]));
 }
 
 void TextRunWalker::setGlyphXPositions(bool isRTL)
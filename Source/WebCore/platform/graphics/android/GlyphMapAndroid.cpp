@@ -36,7 +36,10 @@
 #include "SkTemplates.h"
 #include "SkUtils.h"
 #include "VerticalTextMap.h"
-
+#include <wtf/HashMap.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/StringHasher.h>
+#include <wtf/Vector.h>
 
 using namespace android;
 
@@ -88,19 +91,97 @@ static void convertToVerticalForms(UChar* src, UChar* dest, unsigned bufferLengt
     }
 }
 
-bool GlyphPage::fill(unsigned offset, unsigned length, UChar* buffer, unsigned bufferLength, const SimpleFontData* fontData)
-{
-    if (SkUTF16_IsHighSurrogate(buffer[bufferLength-1])) {
-        SkDebugf("%s last char is high-surrogate", __FUNCTION__);
-        return false;
+// Glyph ids only depend on the typeface and the characters, not on the size or
+// the synthetic bold and italic of a font, yet every FontPlatformData gets its
+// own glyph pages. Remember recently filled pages per typeface so that the same
+// Unicode block in another size of a font does not go through Skia's fallback
+// chain again; for CJK and emoji each of those lookups walks several fonts.
+// Pages the typeface has no glyph for are remembered too, so text in a script
+// the font does not cover fails the coverage check without asking Skia.
+class GlyphFillCache {
+    WTF_MAKE_NONCOPYABLE(GlyphFillCache);
+public:
+    // A page is at most 512 characters and 256 glyphs; this stays under 200KB.
+    static const unsigned maxEntries = 128;
+
+    struct Entry {
+        uint32_t fontID;
+        unsigned flags;
+        Vector<UChar> text;
+        Vector<uint16_t> glyphs;
+        bool haveGlyphs;
+    };
+
+    GlyphFillCache() { }
+
+    const Entry* find(uint32_t fontID, unsigned flags, const UChar* text, unsigned length, unsigned glyphCount)
+    {
+        Map::const_iterator it = m_entries.find(hash(fontID, flags, text, length));
+        if (it == m_entries.end() || !matches(it->second, fontID, flags, text, length, glyphCount))
+            return 0;
+        return it->second;
     }
-    
+
+    void add(uint32_t fontID, unsigned flags, const UChar* text, unsigned length, const uint16_t* glyphs, unsigned glyphCount, bool haveGlyphs)
+    {
+        if (m_entries.size() >= maxEntries) {
+            deleteAllValues(m_entries);
+            m_entries.clear();
+        }
+
+        Entry* entry = new Entry;
+        entry->fontID = fontID;
+        entry->flags = flags;
+        entry->text.append(text, length);
+        entry->glyphs.append(glyphs, glyphCount);
+        entry->haveGlyphs = haveGlyphs;
+
+        // A colliding page simply replaces the one that was there.
+        pair<Map::iterator, bool> result = m_entries.add(hash(fontID, flags, text, length), entry);
+        if (!result.second) {
+            delete result.first->second;
+            result.first->second = entry;
+        }
+    }
+
+private:
+    typedef HashMap<unsigned, Entry*> Map;
+
+    static unsigned hash(uint32_t fontID, unsigned flags, const UChar* text, unsigned length)
+    {
+        uint64_t textHash = StringHasher::computeHash(text, length);
+        unsigned hash = intHash((textHash << 32) | fontID) ^ flags;
+        // 0 and -1 are the empty and deleted values of the map.
+        if (!hash || hash == static_cast<unsigned>(-1))
+            hash = 1;
+        return hash;
+    }
+
+    static bool matches(const Entry* entry, uint32_t fontID, unsigned flags, const UChar* text, unsigned length, unsigned glyphCount)
+    {
+        return entry->fontID == fontID && entry->flags == flags
+            && entry->text.size() == length && entry->glyphs.size() == glyphCount
+            && !memcmp(entry->text.data(), text, length * sizeof(UChar));
+    }
+
+    Map m_entries;
+};
+
+static GlyphFillCache& glyphFillCache()
+{
+    DEFINE_STATIC_LOCAL(GlyphFillCache, cache, ());
+    return cache;
+}
+
+// Maps |buffer| to glyph ids in |glyphs| the way it would be drawn with
+// |fontData|, including the vertical forms and the emoji fallback. Returns
+// false if the characters could not be mapped one glyph per character.
+static bool textToGlyphs(UChar* buffer, unsigned bufferLength, const SimpleFontData* fontData, uint16_t* glyphs, unsigned length)
+{
     SkPaint paint;
     fontData->platformData().setupPaint(&paint);
     paint.setTextEncoding(SkPaint::kUTF16_TextEncoding);
 
-    SkAutoSTMalloc <GlyphPage::size, uint16_t> glyphStorage(length);
-    uint16_t* glyphs = glyphStorage.get();
     UChar *textBuffer = buffer;
     UChar vTextBuffer[bufferLength];
 
@@ -139,28 +220,50 @@ bool GlyphPage::fill(unsigned offset, unsigned length, UChar* buffer, unsigned b
         }
     }
 
-    unsigned allGlyphs = 0; // track if any of the glyphIDs are non-zero
-
     // search for emoji. If we knew for sure that buffer was a contiguous range
     // of chars, we could quick-reject the range to avoid this loop (usually)
     if (EmojiFont::IsAvailable()) {
         const UChar* curr = textBuffer;
         for (unsigned i = 0; i < length; i++) {
             SkUnichar uni = SkUTF16_NextUnichar(&curr);
-            uint16_t glyphID = glyphs[i];
             // only sniff if the normal font failed to recognize it
-            if (!glyphID)
-                glyphID = EmojiFont::UnicharToGlyph(uni);
-            setGlyphDataForIndex(offset + i, glyphID, fontData);
-            allGlyphs |= glyphID;
-        }
-    } else {
-        for (unsigned i = 0; i < length; i++) {
-            uint16_t glyphID = glyphs[i];
-            setGlyphDataForIndex(offset + i, glyphID, fontData);
-            allGlyphs |= glyphID;
+            if (!glyphs[i])
+                glyphs[i] = EmojiFont::UnicharToGlyph(uni);
         }
     }
+    return true;
+}
+
+bool GlyphPage::fill(unsigned offset, unsigned length, UChar* buffer, unsigned bufferLength, const SimpleFontData* fontData)
+{
+    if (SkUTF16_IsHighSurrogate(buffer[bufferLength-1])) {
+        SkDebugf("%s last char is high-surrogate", __FUNCTION__);
+        return false;
+    }
+
+    // Everything but the typeface that changes which glyphs come out.
+    const FontPlatformData& platformData = fontData->platformData();
+    unsigned flags = (platformData.orientation() == Vertical ? 1 : 0) | (fontData->hasVerticalGlyphs() ? 2 : 0);
+    uint32_t fontID = platformData.uniqueID();
+
+    GlyphFillCache& cache = glyphFillCache();
+    if (const GlyphFillCache::Entry* entry = cache.find(fontID, flags, buffer, bufferLength, length)) {
+        for (unsigned i = 0; i < length; i++)
+            setGlyphDataForIndex(offset + i, entry->glyphs[i], fontData);
+        return entry->haveGlyphs;
+    }
+
+    SkAutoSTMalloc <GlyphPage::size, uint16_t> glyphStorage(length);
+    uint16_t* glyphs = glyphStorage.get();
+    if (!textToGlyphs(buffer, bufferLength, fontData, glyphs, length))
+        return false;
+
+    unsigned allGlyphs = 0; // track if any of the glyphIDs are non-zero
+    for (unsigned i = 0; i < length; i++) {
+        setGlyphDataForIndex(offset + i, glyphs[i], fontData);
+        allGlyphs |= glyphs[i];
+    }
+    cache.add(fontID, flags, buffer, bufferLength, glyphs, length, allGlyphs);
     return allGlyphs != 0;
 }
 
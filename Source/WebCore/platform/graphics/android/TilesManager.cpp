@@ -32,6 +32,7 @@
 #include "PaintedSurface.h"
 #include "SkCanvas.h"
 #include "SkDevice.h"
+#include "SkGraphics.h"
 #include "SkPaint.h"
 #include <android/native_window.h>
 #include <cutils/atomic.h>
@@ -79,6 +80,10 @@
 
 #define LAYER_TEXTURES_DESTROY_TIMEOUT 60 // If we do not need layers for 60 seconds, free the textures
 
+// Enough for the glyphs of a couple of fonts at the current and the previous
+// scale; anything above that is released once the UI is hidden.
+#define GLYPH_CACHE_BUDGET (1024 * 1024)
+
 namespace WebCore {
 
 GLint TilesManager::getMaxTextureSize()
@@ -106,6 +111,9 @@ TilesManager::TilesManager()
     , m_drawGLCount(1)
     , m_lastTimeLayersUsed(0)
     , m_hasLayerTextures(false)
+    , m_glyphCacheTiles(0)
+    , m_glyphCacheMissedTiles(0)
+    , m_glyphCacheRasterizedBytes(0)
 {
     XLOG("TilesManager ctor");
     m_textures.reserveCapacity(MAX_TEXTURE_ALLOCATION);
@@ -155,7 +163,7 @@ void TilesManager::allocateTiles()
          m_tilesTextures.size() * LAYER_TILE_WIDTH * LAYER_TILE_HEIGHT * 4 / 1024 / 1024);
 }
 
-void TilesManager::deallocateTextures(bool allTextures)
+int TilesManager::deallocateTextures(bool allTextures)
 {
     const unsigned int max = m_textures.size();
 
@@ -169,12 +177,61 @@ void TilesManager::deallocateTextures(bool allTextures)
                 sparedDrawCount = std::max(sparedDrawCount, owner->drawCount());
         }
     }
-    deallocateTexturesVector(sparedDrawCount, m_textures);
-    deallocateTexturesVector(sparedDrawCount, m_tilesTextures);
+    int dealloc = deallocateTexturesVector(sparedDrawCount, m_textures);
+    dealloc += deallocateTexturesVector(sparedDrawCount, m_tilesTextures);
+
+    // The glyphs only help repaint the textures we just dropped.
+    if (allTextures)
+        purgeGlyphCache();
+    else
+        trimGlyphCache();
+    return dealloc;
+}
+
+void TilesManager::didPaintTile(size_t glyphCacheBytesBefore, size_t glyphCacheBytesAfter)
+{
+    android::Mutex::Autolock lock(m_glyphCacheLock);
+    m_glyphCacheTiles++;
+    // Text measured on the WebCore thread meanwhile also lands in the cache,
+    // so this slightly overcounts the misses.
+    if (glyphCacheBytesAfter > glyphCacheBytesBefore) {
+        m_glyphCacheMissedTiles++;
+        m_glyphCacheRasterizedBytes += glyphCacheBytesAfter - glyphCacheBytesBefore;
+    }
+}
+
+void TilesManager::trimGlyphCache()
+{
+    size_t used = SkGraphics::GetFontCacheUsed();
+    if (used <= GLYPH_CACHE_BUDGET)
+        return;
+    SkGraphics::SetFontCacheUsed(GLYPH_CACHE_BUDGET);
+    XLOG("Trimmed glyph cache from %d to %d bytes (%d bytes now used)",
+         static_cast<int>(used), GLYPH_CACHE_BUDGET, static_cast<int>(SkGraphics::GetFontCacheUsed()));
+}
+
+void TilesManager::purgeGlyphCache()
+{
+#ifdef DEBUG
+    unsigned tiles, missedTiles;
+    size_t rasterizedBytes;
+    getGlyphCacheStats(&tiles, &missedTiles, &rasterizedBytes);
+    XLOG("Purging glyph cache, %u tiles painted, %u of them rasterized glyphs (%d bytes)",
+         tiles, missedTiles, static_cast<int>(rasterizedBytes));
+#endif
+    SkGraphics::SetFontCacheUsed(0);
+}
+
+void TilesManager::getGlyphCacheStats(unsigned* tiles, unsigned* missedTiles, size_t* rasterizedBytes)
+{
+    android::Mutex::Autolock lock(m_glyphCacheLock);
+    *tiles = m_glyphCacheTiles;
+    *missedTiles = m_glyphCacheMissedTiles;
+    *rasterizedBytes = m_glyphCacheRasterizedBytes;
 }
 
-void TilesManager::deallocateTexturesVector(unsigned long long sparedDrawCount,
-                                            WTF::Vector<BaseTileTexture*>& textures)
+int TilesManager::deallocateTexturesVector(unsigned long long sparedDrawCount,
+                                           WTF::Vector<BaseTileTexture*>& textures)
 {
     const unsigned int max = textures.size();
     int dealloc = 0;
@@ -187,6 +244,7 @@ void TilesManager::deallocateTexturesVector(unsigned long long sparedDrawCount,
     }
     XLOG("Deallocated %d gl textures (out of %d base tiles and %d layer tiles)",
          dealloc, max, maxLayer);
+    return dealloc;
 }
 
 void TilesManager::gatherTexturesNumbers(int* nbTextures, int* nbAllocatedTextures,
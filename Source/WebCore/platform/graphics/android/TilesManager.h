@@ -120,7 +120,8 @@ public:
     void allocateTiles();
 
     // Called when webview is hidden to discard graphics memory
-    void deallocateTextures(bool allTextures);
+    // Returns the number of textures freed.
+    int deallocateTextures(bool allTextures);
 
     bool getShowVisualIndicator()
     {
@@ -199,6 +200,16 @@ public:
         return m_paintedSurfaces.size();
     }
 
+    // Text is rasterized into tiles through Skia's glyph cache, which every
+    // painting thread shares and which is keyed by typeface, size, matrix and
+    // glyph id. A tile that makes the cache grow had to rasterize glyphs that
+    // were not there yet. deallocateTextures() trims the cache back to its
+    // budget when the UI is hidden, and empties it with the textures.
+    void didPaintTile(size_t glyphCacheBytesBefore, size_t glyphCacheBytesAfter);
+    void trimGlyphCache();
+    void purgeGlyphCache();
+    void getGlyphCacheStats(unsigned* tiles, unsigned* missedTiles, size_t* rasterizedBytes);
+
 private:
     TilesManager();
 
@@ -209,8 +220,8 @@ private:
             m_generatorReadyCond.wait(m_generatorLock);
     }
 
-    void deallocateTexturesVector(unsigned long long sparedDrawCount,
-                                  WTF::Vector<BaseTileTexture*>& textures);
+    int deallocateTexturesVector(unsigned long long sparedDrawCount,
+                                 WTF::Vector<BaseTileTexture*>& textures);
 
     Vector<BaseTileTexture*> m_textures;
     Vector<BaseTileTexture*> m_availableTextures;
@@ -250,6 +261,11 @@ private:
     unsigned long long m_drawGLCount;
     double m_lastTimeLayersUsed;
     bool m_hasLayerTextures;
+
+    android::Mutex m_glyphCacheLock;
+    unsigned m_glyphCacheTiles;
+    unsigned m_glyphCacheMissedTiles;
+    size_t m_glyphCacheRasterizedBytes;
 };
 
 } // namespace WebCore
@@ -50,7 +50,6 @@ void handleDataURL(ResourceHandle* handle)
     }
 
     String mediaType = url.substring(5, index - 5);
-    String data = url.substring(index + 1);
 
     bool base64 = mediaType.endsWith(";base64", false);
     if (base64)
@@ -68,16 +67,26 @@ void handleDataURL(ResourceHandle* handle)
     response.setURL(handle->firstRequest().url());
 
     if (base64) {
-        data = decodeURLEscapeSequences(data);
         handle->client()->didReceiveResponse(handle, response);
 
+        // Base64 rarely needs unescaping, so decode straight out of the URL
+        // rather than copying the payload first.
+        const UChar* characters = url.characters() + index + 1;
+        unsigned length = url.length() - index - 1;
+        String unescaped;
+        if (url.find('%', index + 1) != notFound) {
+            unescaped = decodeURLEscapeSequences(url.substring(index + 1));
+            characters = unescaped.characters();
+            length = unescaped.length();
+        }
+
         Vector<char> out;
-        if (base64Decode(data, out, IgnoreWhitespace) && out.size() > 0) {
+        if (base64Decode(characters, length, out, IgnoreWhitespace) && out.size() > 0) {
             response.setExpectedContentLength(out.size());
             handle->client()->didReceiveData(handle, out.data(), out.size(), 0);
         }
     } else {
-        data = decodeURLEscapeSequences(data, TextEncoding(charset));
+        String data = decodeURLEscapeSequences(url.substring(index + 1), TextEncoding(charset));
         handle->client()->didReceiveResponse(handle, response);
 
         CString encodedData = TextEncoding().encode(data.characters(), data.length(), URLEncodedEntitiesForUnencodables);
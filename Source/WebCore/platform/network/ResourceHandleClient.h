@@ -55,6 +55,9 @@ namespace WebCore {
     class ResourceError;
     class ResourceRequest;
     class ResourceResponse;
+#if PLATFORM(ANDROID)
+    class SharedBufferSegment;
+#endif
 
     enum CacheStoragePolicy {
         StorageAllowed,
@@ -82,6 +85,12 @@ namespace WebCore {
         virtual bool supportsDataArray() { return false; }
         virtual void didReceiveDataArray(ResourceHandle*, CFArrayRef) { }
 #endif
+#if PLATFORM(ANDROID)
+        // Clients that can keep a reference to the received data instead of
+        // copying it get it through didReceiveDataSegment().
+        virtual bool supportsDataSegments() { return false; }
+        virtual void didReceiveDataSegment(ResourceHandle*, SharedBufferSegment*, int /*encodedDataLength*/) { }
+#endif
 
         virtual void willCacheResponse(ResourceHandle*, CacheStoragePolicy&) { }
 
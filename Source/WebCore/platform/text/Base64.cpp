@@ -41,23 +41,27 @@ static const char base64EncMap[64] = {
     0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x2B, 0x2F
 };
 
-static const char base64DecMap[128] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x3E, 0x00, 0x00, 0x00, 0x3F,
+// Maps ASCII to the value of each base64 digit. '=' maps to
+// base64EqualsSign and every other character to base64Invalid.
+static const unsigned char base64EqualsSign = 0x40;
+static const unsigned char base64Invalid = 0x80;
+static const unsigned char base64DecMap[128] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x3E, 0x80, 0x80, 0x80, 0x3F,
     0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B,
-    0x3C, 0x3D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x3C, 0x3D, 0x80, 0x80, 0x80, 0x40, 0x80, 0x80,
+    0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
     0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
     0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16,
-    0x17, 0x18, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
+    0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20,
     0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
     0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30,
-    0x31, 0x32, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00
+    0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80
 };
 
 String base64Encode(const char* data, unsigned length, bool insertLFs)
@@ -146,56 +150,52 @@ static inline bool base64DecodeInternal(const T* data, unsigned len, Vector<char
     if (!len)
         return true;
 
-    out.grow(len);
+    // Each group of 4 digits is 3 bytes; skipped characters only make the
+    // result shorter.
+    out.grow(len / 4 * 3 + 2);
+    char* destination = out.data();
 
+    // Decodes in a single pass, writing each group out as soon as its fourth
+    // digit is read.
     bool sawEqualsSign = false;
-    unsigned outLength = 0;
+    unsigned digits = 0;
+    unsigned bits = 0;
     for (unsigned idx = 0; idx < len; idx++) {
         unsigned ch = data[idx];
-        if (ch == '=')
-            sawEqualsSign = true;
-        else if (('0' <= ch && ch <= '9') || ('A' <= ch && ch <= 'Z') || ('a' <= ch && ch <= 'z') || ch == '+' || ch == '/') {
+        unsigned value = ch < 128 ? base64DecMap[ch] : base64Invalid;
+        if (value < 64) {
             if (sawEqualsSign)
                 return false;
-            out[outLength] = base64DecMap[ch];
-            outLength++;
-        } else if (policy == FailOnInvalidCharacter || (policy == IgnoreWhitespace && !isSpaceOrNewline(ch)))
+            bits = (bits << 6) | value;
+            if (!(++digits & 3)) {
+                destination[0] = bits >> 16;
+                destination[1] = bits >> 8;
+                destination[2] = bits;
+                destination += 3;
+            }
+        } else if (value == base64EqualsSign)
+            sawEqualsSign = true;
+        else if (policy == FailOnInvalidCharacter || (policy == IgnoreWhitespace && !isSpaceOrNewline(ch)))
             return false;
     }
 
-    if (!outLength)
+    if (!digits)
         return !sawEqualsSign;
 
     // Valid data is (n * 4 + [0,2,3]) characters long.
-    if ((outLength % 4) == 1)
-        return false;
-    
-    // 4-byte to 3-byte conversion
-    outLength -= (outLength + 3) / 4;
-    if (!outLength)
+    switch (digits & 3) {
+    case 1:
         return false;
-
-    unsigned sidx = 0;
-    unsigned didx = 0;
-    if (outLength > 1) {
-        while (didx < outLength - 2) {
-            out[didx] = (((out[sidx] << 2) & 255) | ((out[sidx + 1] >> 4) & 003));
-            out[didx + 1] = (((out[sidx + 1] << 4) & 255) | ((out[sidx + 2] >> 2) & 017));
-            out[didx + 2] = (((out[sidx + 2] << 6) & 255) | (out[sidx + 3] & 077));
-            sidx += 4;
-            didx += 3;
-        }
+    case 2:
+        *destination++ = bits >> 4;
+        break;
+    case 3:
+        *destination++ = bits >> 10;
+        *destination++ = bits >> 2;
+        break;
     }
 
-    if (didx < outLength)
-        out[didx] = (((out[sidx] << 2) & 255) | ((out[sidx + 1] >> 4) & 003));
-
-    if (++didx < outLength)
-        out[didx] = (((out[sidx + 1] << 4) & 255) | ((out[sidx + 2] >> 2) & 017));
-
-    if (outLength < out.size())
-        out.shrink(outLength);
-
+    out.shrink(destination - out.data());
     return true;
 }
 
@@ -204,6 +204,11 @@ bool base64Decode(const char* data, unsigned len, Vector<char>& out, Base64Decod
     return base64DecodeInternal<char>(data, len, out, policy);
 }
 
+bool base64Decode(const UChar* data, unsigned len, Vector<char>& out, Base64DecodePolicy policy)
+{
+    return base64DecodeInternal<UChar>(data, len, out, policy);
+}
+
 bool base64Decode(const String& in, Vector<char>& out, Base64DecodePolicy policy)
 {
     return base64DecodeInternal<UChar>(in.characters(), in.length(), out, policy);
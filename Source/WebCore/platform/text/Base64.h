@@ -45,6 +45,7 @@ String base64Encode(const CString&, bool insertLFs = false);
 bool base64Decode(const String&, Vector<char>&, Base64DecodePolicy = FailOnInvalidCharacter);
 bool base64Decode(const Vector<char>&, Vector<char>&, Base64DecodePolicy = FailOnInvalidCharacter);
 bool base64Decode(const char*, unsigned, Vector<char>&, Base64DecodePolicy = FailOnInvalidCharacter);
+bool base64Decode(const UChar*, unsigned, Vector<char>&, Base64DecodePolicy = FailOnInvalidCharacter);
 
 inline void base64Encode(const Vector<char>& in, Vector<char>& out, bool insertLFs)
 {
@@ -26,6 +26,7 @@
 #include "RenderTableCell.h"
 #include "RenderTableCol.h"
 #include "RenderTableSection.h"
+#include <algorithm>
 
 using namespace std;
 
@@ -35,6 +36,7 @@ AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
     , m_hasPercent(false)
     , m_effectiveLogicalWidthDirty(true)
+    , m_needsFullRecalc(true)
 {
 }
 
@@ -42,7 +44,7 @@ AutoTableLayout::~AutoTableLayout()
 {
 }
 
-void AutoTableLayout::recalcColumn(int effCol)
+void AutoTableLayout::recalcColumn(int effCol, bool collectSpanCells)
 {
     Layout& columnLayout = m_layoutStruct[effCol];
 
@@ -121,7 +123,8 @@ void AutoTableLayout::recalcColumn(int effCol)
                     // a min/max width of at least 1px for this column now.
                     columnLayout.minLogicalWidth = max(columnLayout.minLogicalWidth, cellHasContent ? 1 : 0);
                     columnLayout.maxLogicalWidth = max(columnLayout.maxLogicalWidth, 1);
-                    insertSpanCell(cell);
+                    if (collectSpanCells)
+                        insertSpanCell(cell);
                 }
             }
         }
@@ -142,6 +145,8 @@ void AutoTableLayout::fullRecalc()
 {
     m_hasPercent = false;
     m_effectiveLogicalWidthDirty = true;
+    m_needsFullRecalc = false;
+    m_dirtyColumns.clear();
 
     int nEffCols = m_table->numEffCols();
     m_layoutStruct.resize(nEffCols);
@@ -181,8 +186,59 @@ void AutoTableLayout::fullRecalc()
         child = next;
     }
 
+    m_columnElementLayoutStruct = m_layoutStruct;
+
     for (int i = 0; i < nEffCols; i++)
-        recalcColumn(i);
+        recalcColumn(i, true);
+}
+
+void AutoTableLayout::recalcDirtyColumns()
+{
+    if (m_dirtyColumns.isEmpty())
+        return;
+
+    m_effectiveLogicalWidthDirty = true;
+
+    // Spanning cells never get here, so the span cell list is still right.
+    // m_hasPercent may stay set after the last percent cell of a column is
+    // gone, which only costs layout() a look for percent columns.
+    std::sort(m_dirtyColumns.begin(), m_dirtyColumns.end());
+    int lastColumn = -1;
+    for (size_t i = 0; i < m_dirtyColumns.size(); ++i) {
+        int effCol = m_dirtyColumns[i];
+        if (effCol == lastColumn)
+            continue;
+        lastColumn = effCol;
+        m_layoutStruct[effCol] = m_columnElementLayoutStruct[effCol];
+        recalcColumn(effCol, false);
+    }
+    m_dirtyColumns.clear();
+}
+
+void AutoTableLayout::cellPreferredLogicalWidthsChanged(RenderTableCell* cell)
+{
+    if (m_needsFullRecalc)
+        return;
+
+    // Spanning cells feed calcEffectiveLogicalWidth() through m_spanCells, and
+    // collapsed borders tie the widths of neighbouring cells together.
+    if (cell->colSpan() != 1 || !cell->section() || m_table->collapseBorders()) {
+        setNeedsFullRecalc();
+        return;
+    }
+
+    int effCol = m_table->colToEffCol(cell->col());
+    if (effCol < 0 || static_cast<size_t>(effCol) >= m_layoutStruct.size() || m_dirtyColumns.size() >= m_layoutStruct.size()) {
+        setNeedsFullRecalc();
+        return;
+    }
+    m_dirtyColumns.append(effCol);
+}
+
+void AutoTableLayout::setNeedsFullRecalc()
+{
+    m_needsFullRecalc = true;
+    m_dirtyColumns.clear();
 }
 
 // FIXME: This needs to be adapted for vertical writing modes.
@@ -221,7 +277,10 @@ static bool shouldScaleColumns(RenderTable* table)
 
 void AutoTableLayout::computePreferredLogicalWidths(int& minWidth, int& maxWidth)
 {
-    fullRecalc();
+    if (m_needsFullRecalc || m_layoutStruct.size() != static_cast<size_t>(m_table->numEffCols()))
+        fullRecalc();
+    else
+        recalcDirtyColumns();
 
     int spanMaxLogicalWidth = calcEffectiveLogicalWidth();
     minWidth = 0;
@@ -38,9 +38,13 @@ public:
     virtual void computePreferredLogicalWidths(int& minWidth, int& maxWidth);
     virtual void layout();
 
+    virtual void cellPreferredLogicalWidthsChanged(RenderTableCell*);
+    virtual void setNeedsFullRecalc();
+
 private:
     void fullRecalc();
-    void recalcColumn(int effCol);
+    void recalcDirtyColumns();
+    void recalcColumn(int effCol, bool collectSpanCells);
 
     int calcEffectiveLogicalWidth();
 
@@ -68,9 +72,16 @@ private:
     };
 
     Vector<Layout, 4> m_layoutStruct;
+    // What the <col> elements alone give each column, for starting over a
+    // single column without walking the column elements again.
+    Vector<Layout, 4> m_columnElementLayoutStruct;
     Vector<RenderTableCell*, 4> m_spanCells;
+    // Columns whose cells changed their preferred widths since the last
+    // recalc, possibly repeated.
+    Vector<int> m_dirtyColumns;
     bool m_hasPercent : 1;
     mutable bool m_effectiveLogicalWidthDirty : 1;
+    bool m_needsFullRecalc : 1;
 };
 
 } // namespace WebCore
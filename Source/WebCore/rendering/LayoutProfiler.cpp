@@ -0,0 +1,359 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "LayoutProfiler.h"
+
+#ifdef ANDROID_INSTRUMENT
+
+#include "Element.h"
+#include "RenderObject.h"
+#include <cutils/properties.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/Vector.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+// Renderers whose layout took less than this are left out of the dump, so
+// that a pass over a large page stays readable.
+static const double minimumRecordedTime = 0.0001;
+static const size_t maxEntriesPerPass = 500;
+static const size_t maxDirtyRootsPerPass = 32;
+static const size_t maxPasses = 32;
+
+bool LayoutProfiler::s_enabled = false;
+LayoutProfiler::Cause LayoutProfiler::s_currentCause = LayoutProfiler::UnknownCause;
+
+namespace {
+
+struct Entry {
+    String renderer;
+    unsigned depth;
+    double totalTime;
+    double selfTime;
+};
+
+struct DirtyRoot {
+    String renderer;
+    LayoutProfiler::Cause cause;
+};
+
+struct Pass {
+    Pass()
+        : startTime(0)
+        , duration(0)
+        , subtree(false)
+        , droppedEntries(0)
+    {
+        memset(marks, 0, sizeof(marks));
+    }
+
+    double startTime;
+    double duration;
+    String root;
+    bool subtree;
+    unsigned marks[LayoutProfiler::NumberOfCauses];
+    Vector<DirtyRoot> dirtyRoots;
+    Vector<Entry> entries;
+    unsigned droppedEntries;
+};
+
+struct TimedLayout {
+    RenderObject* renderer;
+    double startTime;
+    double childTime;
+    bool recorded;
+};
+
+struct ProfilerState {
+    ProfilerState()
+        : passDepth(0)
+        , stackBase(0)
+        , checkedProperty(false)
+    {
+    }
+
+    // Marks made since the last pass; they are handed to the next one.
+    Pass pending;
+    Pass current;
+    Vector<Pass> passes;
+    Vector<TimedLayout> stack;
+    unsigned passDepth;
+    size_t stackBase;
+    bool checkedProperty;
+};
+
+} // namespace
+
+static ProfilerState& state()
+{
+    DEFINE_STATIC_LOCAL(ProfilerState, profilerState, ());
+    return profilerState;
+}
+
+static const char* causeName(LayoutProfiler::Cause cause)
+{
+    switch (cause) {
+    case LayoutProfiler::StyleChange:
+        return "style";
+    case LayoutProfiler::TreeChange:
+        return "tree";
+    case LayoutProfiler::TextChange:
+        return "text";
+    case LayoutProfiler::ResourceLoad:
+        return "resource";
+    case LayoutProfiler::ViewChange:
+        return "view";
+    case LayoutProfiler::UnknownCause:
+    case LayoutProfiler::NumberOfCauses:
+        break;
+    }
+    return "unknown";
+}
+
+static String describe(RenderObject* renderer)
+{
+    String description = renderer->renderName();
+    Node* node = renderer->node();
+    if (renderer->isAnonymous() || !node || !node->isElementNode())
+        return description;
+
+    Element* element = static_cast<Element*>(node);
+    description += " " + element->localName().string();
+    const AtomicString& id = element->getIdAttribute();
+    if (!id.isEmpty())
+        description += "#" + id.string();
+    return description;
+}
+
+static void appendQuoted(StringBuilder& builder, const String& string)
+{
+    builder.append('"');
+    for (unsigned i = 0; i < string.length(); ++i) {
+        UChar c = string[i];
+        if (c == '"' || c == '\\') {
+            builder.append('\\');
+            builder.append(c);
+        } else if (c < 0x20)
+            builder.append(String::format("\\u%04x", c));
+        else
+            builder.append(c);
+    }
+    builder.append('"');
+}
+
+static String milliseconds(double seconds)
+{
+    return String::format("%.3f", seconds * 1000);
+}
+
+void LayoutProfiler::setEnabled(bool enabled)
+{
+    ProfilerState& profiler = state();
+    profiler.checkedProperty = true;
+    if (enabled == s_enabled)
+        return;
+    // Scopes that are already open stay balanced: each one remembers whether
+    // it pushed a frame.
+    s_enabled = enabled;
+    if (!enabled)
+        reset();
+}
+
+void LayoutProfiler::willLayout(RenderObject* root, bool subtree)
+{
+    ProfilerState& profiler = state();
+    if (!profiler.checkedProperty) {
+        profiler.checkedProperty = true;
+        char value[PROPERTY_VALUE_MAX];
+        property_get("webcore.layoutprofiler.enable", value, "0");
+        s_enabled = atoi(value);
+    }
+    if (!s_enabled)
+        return;
+
+    if (profiler.passDepth++)
+        return;
+
+    profiler.current = profiler.pending;
+    profiler.pending = Pass();
+    profiler.current.startTime = currentTime();
+    profiler.current.root = describe(root);
+    profiler.current.subtree = subtree;
+    profiler.stackBase = profiler.stack.size();
+}
+
+void LayoutProfiler::didLayout()
+{
+    ProfilerState& profiler = state();
+    if (!profiler.passDepth || --profiler.passDepth)
+        return;
+
+    profiler.current.duration = currentTime() - profiler.current.startTime;
+    if (profiler.passes.size() >= maxPasses)
+        profiler.passes.remove(0);
+    profiler.passes.append(profiler.current);
+    profiler.current = Pass();
+}
+
+void LayoutProfiler::didMarkNeedsLayout(RenderObject* renderer)
+{
+    ProfilerState& profiler = state();
+    // Renderers marked while a pass is running are the pass itself at work
+    // (a parent dirtying its children), not a reason for it.
+    if (profiler.passDepth)
+        return;
+
+    Pass& pending = profiler.pending;
+    ++pending.marks[s_currentCause];
+    if (pending.dirtyRoots.size() < maxDirtyRootsPerPass) {
+        DirtyRoot dirtyRoot;
+        dirtyRoot.renderer = describe(renderer);
+        dirtyRoot.cause = s_currentCause;
+        pending.dirtyRoots.append(dirtyRoot);
+    }
+}
+
+void LayoutProfiler::enter(RenderObject* renderer)
+{
+    ProfilerState& profiler = state();
+    TimedLayout frame;
+    frame.renderer = renderer;
+    frame.startTime = currentTime();
+    frame.childTime = 0;
+    frame.recorded = profiler.passDepth;
+    profiler.stack.append(frame);
+}
+
+void LayoutProfiler::leave()
+{
+    ProfilerState& profiler = state();
+    ASSERT(!profiler.stack.isEmpty());
+    TimedLayout frame = profiler.stack.last();
+    profiler.stack.removeLast();
+
+    double totalTime = currentTime() - frame.startTime;
+    if (!profiler.stack.isEmpty())
+        profiler.stack.last().childTime += totalTime;
+
+    if (!frame.recorded || totalTime < minimumRecordedTime)
+        return;
+
+    Pass& pass = profiler.current;
+    if (pass.entries.size() >= maxEntriesPerPass) {
+        ++pass.droppedEntries;
+        return;
+    }
+    Entry entry;
+    entry.renderer = describe(frame.renderer);
+    entry.depth = profiler.stack.size() > profiler.stackBase ? profiler.stack.size() - profiler.stackBase : 0;
+    entry.totalTime = totalTime;
+    entry.selfTime = totalTime - frame.childTime;
+    pass.entries.append(entry);
+}
+
+String LayoutProfiler::toJSON()
+{
+    ProfilerState& profiler = state();
+    StringBuilder json;
+    json.append("{\"enabled\":");
+    json.append(s_enabled ? "true" : "false");
+    json.append(",\"passes\":[");
+    for (size_t i = 0; i < profiler.passes.size(); ++i) {
+        const Pass& pass = profiler.passes[i];
+        if (i)
+            json.append(',');
+        json.append("\n{\"start\":");
+        json.append(String::format("%.3f", pass.startTime));
+        json.append(",\"duration_ms\":");
+        json.append(milliseconds(pass.duration));
+        json.append(",\"root\":");
+        appendQuoted(json, pass.root);
+        json.append(",\"subtree\":");
+        json.append(pass.subtree ? "true" : "false");
+
+        json.append(",\"causes\":{");
+        bool first = true;
+        for (int cause = 0; cause < NumberOfCauses; ++cause) {
+            if (!pass.marks[cause])
+                continue;
+            if (!first)
+                json.append(',');
+            first = false;
+            appendQuoted(json, causeName(static_cast<Cause>(cause)));
+            json.append(':');
+            json.append(String::number(pass.marks[cause]));
+        }
+        json.append('}');
+
+        json.append(",\"dirty_roots\":[");
+        for (size_t j = 0; j < pass.dirtyRoots.size(); ++j) {
+            if (j)
+                json.append(',');
+            json.append("{\"renderer\":");
+            appendQuoted(json, pass.dirtyRoots[j].renderer);
+            json.append(",\"cause\":");
+            appendQuoted(json, causeName(pass.dirtyRoots[j].cause));
+            json.append('}');
+        }
+        json.append(']');
+
+        // Entries are in post-order: a renderer comes after its descendants.
+        json.append(",\"renderers\":[");
+        for (size_t j = 0; j < pass.entries.size(); ++j) {
+            const Entry& entry = pass.entries[j];
+            if (j)
+                json.append(',');
+            json.append("\n {\"renderer\":");
+            appendQuoted(json, entry.renderer);
+            json.append(",\"depth\":");
+            json.append(String::number(entry.depth));
+            json.append(",\"total_ms\":");
+            json.append(milliseconds(entry.totalTime));
+            json.append(",\"self_ms\":");
+            json.append(milliseconds(entry.selfTime));
+            json.append('}');
+        }
+        json.append("],\"dropped\":");
+        json.append(String::number(pass.droppedEntries));
+        json.append('}');
+    }
+    json.append("]}\n");
+    return json.toString();
+}
+
+void LayoutProfiler::reset()
+{
+    ProfilerState& profiler = state();
+    profiler.passes.clear();
+    profiler.pending = Pass();
+}
+
+} // namespace WebCore
+
+#endif // ANDROID_INSTRUMENT
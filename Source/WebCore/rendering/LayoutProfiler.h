@@ -0,0 +1,120 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LayoutProfiler_h
+#define LayoutProfiler_h
+
+#ifdef ANDROID_INSTRUMENT
+
+#include <wtf/Forward.h>
+
+namespace WebCore {
+
+class RenderObject;
+
+// LayoutProfiler breaks the time of each FrameView::layout() down by
+// RenderObject subtree, and remembers which renderers were marked as needing
+// layout before the pass and what marked them. It complements the whole-pass
+// TimeCounter::LayoutTimeCounter bucket.
+//
+// It is only built into instrumented builds and is switched on with
+//   adb shell setprop webcore.layoutprofiler.enable 1
+// The recorded passes are dumped as JSON by WebViewCore::dumpRenderTree() and
+// by the "DLPF" debug server command.
+class LayoutProfiler {
+public:
+    // What was going on when a renderer was first marked for layout.
+    enum Cause {
+        UnknownCause,
+        StyleChange,    // Document::recalcStyle()
+        TreeChange,     // Renderers added to or removed from the tree.
+        TextChange,     // RenderText::setText()
+        ResourceLoad,   // An image finished loading or changed size.
+        ViewChange,     // FrameView::setNeedsLayout(): resize, zoom, scrollbars.
+        NumberOfCauses
+    };
+
+    static bool isEnabled() { return s_enabled; }
+    static void setEnabled(bool);
+
+    // Bracket the root layout() call of FrameView::layout(). Nested calls (for
+    // subframes) are folded into the outermost pass.
+    static void willLayout(RenderObject* root, bool subtree);
+    static void didLayout();
+
+    // Called when |renderer| goes from clean to needing layout.
+    static void didMarkNeedsLayout(RenderObject* renderer);
+
+    static String toJSON();
+    static void reset();
+
+    // Times a single RenderObject::layout() call, including its children.
+    class Scope {
+    public:
+        Scope(RenderObject* renderer)
+            : m_active(LayoutProfiler::isEnabled())
+        {
+            if (m_active)
+                LayoutProfiler::enter(renderer);
+        }
+
+        ~Scope()
+        {
+            if (m_active)
+                LayoutProfiler::leave();
+        }
+
+    private:
+        bool m_active;
+    };
+
+    // Attributes any renderer marked for layout while in scope to |cause|.
+    class CauseScope {
+    public:
+        CauseScope(Cause cause)
+            : m_previousCause(s_currentCause)
+        {
+            s_currentCause = cause;
+        }
+
+        ~CauseScope() { s_currentCause = m_previousCause; }
+
+    private:
+        Cause m_previousCause;
+    };
+
+private:
+    static void enter(RenderObject*);
+    static void leave();
+
+    static bool s_enabled;
+    static Cause s_currentCause;
+};
+
+} // namespace WebCore
+
+#endif // ANDROID_INSTRUMENT
+
+#endif // LayoutProfiler_h
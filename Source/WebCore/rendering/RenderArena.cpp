@@ -39,6 +39,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <wtf/Assertions.h>
+#include <wtf/PageAllocationAligned.h>
+
+#ifdef ANDROID_INSTRUMENT
+#include <utils/Log.h>
+#endif
 
 #define ROUNDUP(x, y) ((((x)+((y)-1))/(y))*(y))
 
@@ -59,20 +64,218 @@ static const size_t debugHeaderSize = ARENA_ALIGN(sizeof(RenderArenaDebugHeader)
 
 #endif
 
+// A block of objects of a single size. The slab header sits at the start of
+// the block, which is aligned to its size, so the slab of an object is found
+// by masking its address.
+class RenderArenaSlab {
+public:
+    static const size_t slabSize = 16 * 1024;
+    static const uintptr_t slabMask = ~(slabSize - 1);
+
+    static RenderArenaSlab* create(size_t objectSize)
+    {
+        PageAllocationAligned allocation = PageAllocationAligned::allocate(slabSize, slabSize);
+        if (!static_cast<bool>(allocation))
+            CRASH();
+        return new (allocation.base()) RenderArenaSlab(allocation, objectSize);
+    }
+
+    static void destroy(RenderArenaSlab* slab)
+    {
+        slab->m_allocation.deallocate();
+    }
+
+    static RenderArenaSlab* slabFor(const void* p)
+    {
+        return reinterpret_cast<RenderArenaSlab*>(reinterpret_cast<uintptr_t>(p) & slabMask);
+    }
+
+    void* allocate()
+    {
+        void* result = m_freeList;
+        if (result)
+            m_freeList = *static_cast<void**>(result);
+        else {
+            ASSERT(m_carvedObjects < m_capacity);
+            result = objects() + m_carvedObjects++ * m_objectSize;
+        }
+        ++m_liveObjects;
+        return result;
+    }
+
+    void free(void* ptr)
+    {
+        ASSERT(slabFor(ptr) == this);
+        ASSERT(m_liveObjects);
+        *static_cast<void**>(ptr) = m_freeList;
+        m_freeList = ptr;
+        --m_liveObjects;
+    }
+
+    bool isFull() const { return m_liveObjects == m_capacity; }
+    bool isEmpty() const { return !m_liveObjects; }
+    size_t capacity() const { return m_capacity; }
+
+    RenderArenaSlab* prev() const { return m_prev; }
+    RenderArenaSlab* next() const { return m_next; }
+
+    void insertInto(RenderArenaSlab*& head)
+    {
+        m_prev = 0;
+        m_next = head;
+        if (head)
+            head->m_prev = this;
+        head = this;
+    }
+
+    void removeFrom(RenderArenaSlab*& head)
+    {
+        if (m_prev)
+            m_prev->m_next = m_next;
+        else
+            head = m_next;
+        if (m_next)
+            m_next->m_prev = m_prev;
+        m_prev = 0;
+        m_next = 0;
+    }
+
+private:
+    static const size_t headerSize;
+
+    RenderArenaSlab(const PageAllocationAligned& allocation, size_t objectSize)
+        : m_allocation(allocation)
+        , m_prev(0)
+        , m_next(0)
+        , m_freeList(0)
+        , m_objectSize(objectSize)
+        , m_capacity((slabSize - headerSize) / objectSize)
+        , m_liveObjects(0)
+        , m_carvedObjects(0)
+    {
+    }
+
+    char* objects() { return reinterpret_cast<char*>(this) + headerSize; }
+
+    PageAllocationAligned m_allocation;
+    RenderArenaSlab* m_prev;
+    RenderArenaSlab* m_next;
+    // Objects freed since the slab was created; objects past m_carvedObjects
+    // have never been handed out.
+    void* m_freeList;
+    size_t m_objectSize;
+    size_t m_capacity;
+    size_t m_liveObjects;
+    size_t m_carvedObjects;
+};
+
+const size_t RenderArenaSlab::headerSize = ARENA_ALIGN(sizeof(RenderArenaSlab));
+
+// At most this many empty slabs are kept for reuse, across all size classes.
+static const size_t maxFreeSlabs = 16;
+
+RenderArenaSlab* RenderArena::s_freeSlabs[RenderArena::sizeClassCount];
+size_t RenderArena::s_freeSlabCount = 0;
+
 RenderArena::RenderArena(unsigned arenaSize)
 {
     // Initialize the arena pool
     INIT_ARENA_POOL(&m_pool, "RenderArena", arenaSize);
 
-    // Zero out the recyclers array
-    memset(m_recyclers, 0, sizeof(m_recyclers));
+    memset(m_sizeClasses, 0, sizeof(m_sizeClasses));
 }
 
 RenderArena::~RenderArena()
 {
+    for (size_t i = 0; i < sizeClassCount; ++i) {
+        SizeClass& sizeClass = m_sizeClasses[i];
+        while (RenderArenaSlab* slab = sizeClass.partialSlabs) {
+            slab->removeFrom(sizeClass.partialSlabs);
+            if (slab->isEmpty())
+                poolOrDestroySlab(i, slab);
+            else
+                RenderArenaSlab::destroy(slab);
+        }
+        while (RenderArenaSlab* slab = sizeClass.fullSlabs) {
+            slab->removeFrom(sizeClass.fullSlabs);
+            RenderArenaSlab::destroy(slab);
+        }
+    }
+
     FinishArenaPool(&m_pool);
 }
 
+void* RenderArena::allocateFromSizeClass(size_t size)
+{
+    size_t index = size / sizeClassGranularity - 1;
+    SizeClass& sizeClass = m_sizeClasses[index];
+
+    RenderArenaSlab* slab = sizeClass.partialSlabs;
+    if (!slab) {
+        slab = s_freeSlabs[index];
+        if (slab) {
+            slab->removeFrom(s_freeSlabs[index]);
+            --s_freeSlabCount;
+        } else
+            slab = RenderArenaSlab::create(size);
+        slab->insertInto(sizeClass.partialSlabs);
+        ++sizeClass.slabCount;
+    }
+
+    void* result = slab->allocate();
+    ++sizeClass.liveObjects;
+    if (slab->isFull()) {
+        slab->removeFrom(sizeClass.partialSlabs);
+        slab->insertInto(sizeClass.fullSlabs);
+    }
+    return result;
+}
+
+void RenderArena::freeToSizeClass(size_t size, void* ptr)
+{
+    size_t index = size / sizeClassGranularity - 1;
+    SizeClass& sizeClass = m_sizeClasses[index];
+    RenderArenaSlab* slab = RenderArenaSlab::slabFor(ptr);
+
+    if (slab->isFull()) {
+        slab->removeFrom(sizeClass.fullSlabs);
+        slab->insertInto(sizeClass.partialSlabs);
+    }
+    slab->free(ptr);
+    --sizeClass.liveObjects;
+
+    // Keep one slab with free space in the size class itself.
+    if (slab->isEmpty() && (slab->prev() || slab->next())) {
+        slab->removeFrom(sizeClass.partialSlabs);
+        --sizeClass.slabCount;
+        poolOrDestroySlab(index, slab);
+    }
+}
+
+void RenderArena::poolOrDestroySlab(size_t sizeClassIndex, RenderArenaSlab* slab)
+{
+    ASSERT(slab->isEmpty());
+    if (s_freeSlabCount >= maxFreeSlabs) {
+        RenderArenaSlab::destroy(slab);
+        return;
+    }
+    slab->insertInto(s_freeSlabs[sizeClassIndex]);
+    ++s_freeSlabCount;
+}
+
+size_t RenderArena::releaseFreeSlabs()
+{
+    size_t released = s_freeSlabCount * RenderArenaSlab::slabSize;
+    for (size_t i = 0; i < sizeClassCount; ++i) {
+        while (RenderArenaSlab* slab = s_freeSlabs[i]) {
+            slab->removeFrom(s_freeSlabs[i]);
+            RenderArenaSlab::destroy(slab);
+        }
+    }
+    s_freeSlabCount = 0;
+    return released;
+}
+
 void* RenderArena::allocate(size_t size)
 {
 #ifndef NDEBUG
@@ -85,28 +288,14 @@ void* RenderArena::allocate(size_t size)
     header->signature = signature;
     return static_cast<char*>(block) + debugHeaderSize;
 #else
-    void* result = 0;
-
-    // Ensure we have correct alignment for pointers.  Important for Tru64
-    size = ROUNDUP(size, sizeof(void*));
-
-    // Check recyclers first
-    if (size < gMaxRecycledSize) {
-        const int index = size >> 2;
-
-        result = m_recyclers[index];
-        if (result) {
-            // Need to move to the next object
-            void* next = *((void**)result);
-            m_recyclers[index] = next;
-        }
-    }
-
-    if (!result) {
-        // Allocate a new chunk from the arena
-        ARENA_ALLOCATE(result, &m_pool, size);
-    }
+    // Size classes also keep objects aligned for pointers.
+    size = size ? ROUNDUP(size, sizeClassGranularity) : sizeClassGranularity;
+    if (size <= gMaxRecycledSize)
+        return allocateFromSizeClass(size);
 
+    // Allocate a new chunk from the arena
+    void* result = 0;
+    ARENA_ALLOCATE(result, &m_pool, size);
     return result;
 #endif
 }
@@ -123,23 +312,38 @@ void RenderArena::free(size_t size, void* ptr)
     header->signature = signatureDead;
     ::free(block);
 #else
-    // Ensure we have correct alignment for pointers.  Important for Tru64
-    size = ROUNDUP(size, sizeof(void*));
+    size = size ? ROUNDUP(size, sizeClassGranularity) : sizeClassGranularity;
+    if (size <= gMaxRecycledSize)
+        freeToSizeClass(size, ptr);
 
-    // See if it's a size that we recycle
-    if (size < gMaxRecycledSize) {
-        const int index = size >> 2;
-        void* currentTop = m_recyclers[index];
-        m_recyclers[index] = ptr;
-        *((void**)ptr) = currentTop;
-    }
+    // Larger objects stay in the arena pool until the arena is destroyed.
 #endif
 }
 
 #ifdef ANDROID_INSTRUMENT
 size_t RenderArena::reportPoolSize() const
 {
-    return ReportPoolSize(&m_pool);
+    size_t slabBytes = 0;
+    for (size_t i = 0; i < sizeClassCount; ++i)
+        slabBytes += m_sizeClasses[i].slabCount * RenderArenaSlab::slabSize;
+    return ReportPoolSize(&m_pool) + slabBytes;
+}
+
+void RenderArena::reportSizeClasses() const
+{
+    for (size_t i = 0; i < sizeClassCount; ++i) {
+        const SizeClass& sizeClass = m_sizeClasses[i];
+        if (!sizeClass.slabCount)
+            continue;
+        size_t objectSize = (i + 1) * sizeClassGranularity;
+        size_t liveBytes = sizeClass.liveObjects * objectSize;
+        // Everything in the slabs that is not a live object: free objects,
+        // slab headers and the tail of each slab that fits no object.
+        size_t freeBytes = sizeClass.slabCount * RenderArenaSlab::slabSize - liveBytes;
+        LOGD("Render arena %d byte objects: %d slabs, %d bytes live, %d bytes free",
+            objectSize, sizeClass.slabCount, liveBytes, freeBytes);
+    }
+    LOGD("Render arenas keep %d empty slabs for reuse", s_freeSlabCount);
 }
 #endif
 
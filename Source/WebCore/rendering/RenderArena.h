@@ -43,6 +43,8 @@ namespace WebCore {
 
 static const size_t gMaxRecycledSize = 400;
 
+class RenderArenaSlab;
+
 class RenderArena {
     WTF_MAKE_NONCOPYABLE(RenderArena); WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -53,17 +55,49 @@ public:
     void* allocate(size_t);
     void free(size_t, void*);
 
+    // Unmaps the empty slabs kept for reuse by all arenas. Returns the number
+    // of bytes released.
+    static size_t releaseFreeSlabs();
+
 #ifdef ANDROID_INSTRUMENT
     size_t reportPoolSize() const;
+    // Logs the live and free bytes of each size class.
+    void reportSizeClasses() const;
 #endif
 
 private:
-    // Underlying arena pool
+    // Objects up to gMaxRecycledSize are rounded up to a multiple of
+    // sizeClassGranularity and carved out of slabs that only hold objects of
+    // that size. A slab whose objects are all freed goes to a small pool
+    // shared by all arenas, unless it is the last one of its size class with
+    // free space; relayout frees and reallocates line boxes in bursts, so
+    // unmapping it straight away would just map it again moments later. The
+    // pool is emptied by releaseFreeSlabs() under memory pressure.
+    static const size_t sizeClassGranularity = 8;
+    static const size_t sizeClassCount = gMaxRecycledSize / sizeClassGranularity;
+
+    struct SizeClass {
+        // Slabs with at least one free object, and slabs without any.
+        RenderArenaSlab* partialSlabs;
+        RenderArenaSlab* fullSlabs;
+        size_t slabCount;
+        size_t liveObjects;
+    };
+
+    void* allocateFromSizeClass(size_t);
+    void freeToSizeClass(size_t, void*);
+
+    static void poolOrDestroySlab(size_t sizeClassIndex, RenderArenaSlab*);
+
+    // The empty slabs of each size class kept for reuse, and how many there
+    // are in total.
+    static RenderArenaSlab* s_freeSlabs[sizeClassCount];
+    static size_t s_freeSlabCount;
+
+    // Underlying arena pool, for objects too large for a size class.
     ArenaPool m_pool;
 
-    // The recycler array is sparse with the indices being multiples of 4,
-    // i.e., 0, 4, 8, 12, 16, 20, ...
-    void* m_recyclers[gMaxRecycledSize >> 2];
+    SizeClass m_sizeClasses[sizeClassCount];
 };
 
 } // namespace WebCore
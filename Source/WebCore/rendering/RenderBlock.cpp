@@ -1175,6 +1175,11 @@ void RenderBlock::layoutBlock(bool relayoutChildren, int pageLogicalHeight)
     if (isInline() && !isInlineBlockOrInlineTable()) // Inline <form>s inside various table elements can
         return;                                      // cause us to come in here.  Just bail.
 
+    // Our children are about to move, and so are we within our parent.
+    clearChildHitTestIndex();
+    if (parent() && parent()->isRenderBlock())
+        toRenderBlock(parent())->clearChildHitTestIndex();
+
     if (!relayoutChildren && simplifiedLayout())
         return;
 
@@ -4076,6 +4081,112 @@ bool RenderBlock::hitTestColumns(const HitTestRequest& request, HitTestResult& r
     return false;
 }
 
+// Finds the block children that may contain a hit test area without visiting
+// all of them. Each child that culls itself by its visual overflow (see
+// RenderBlock::nodeAtPoint()) is kept in tree order with the vertical extent
+// of that overflow. The running maximum of the bottoms from the first child and
+// the running minimum of the tops from the last child are both monotonic, so
+// the children that can overlap a vertical range lie between two binary
+// searches, whatever the order of the children on screen. Other children are
+// always returned.
+class RenderBlock::ChildHitTestIndex {
+    WTF_MAKE_NONCOPYABLE(ChildHitTestIndex); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // A block with fewer children than this is just walked.
+    static const unsigned minimumChildCount = 32;
+
+    explicit ChildHitTestIndex(RenderBlock* block)
+    {
+        unsigned order = 0;
+        for (RenderBox* child = block->firstChildBox(); child; child = child->nextSiblingBox(), ++order) {
+            if (!child->isRenderBlock() || child->isTable()) {
+                m_uncullableChildren.append(Entry(child, order, 0, 0));
+                continue;
+            }
+            IntRect overflowBox = child->visualOverflowRect();
+            overflowBox.move(child->x(), child->y());
+            m_children.append(Entry(child, order, overflowBox.y(), overflowBox.maxY()));
+        }
+
+        size_t size = m_children.size();
+        m_maxBottom.resize(size);
+        m_minTop.resize(size);
+        for (size_t i = 0; i < size; ++i)
+            m_maxBottom[i] = i ? max(m_maxBottom[i - 1], m_children[i].bottom) : m_children[i].bottom;
+        for (size_t i = size; i > 0; --i)
+            m_minTop[i - 1] = i < size ? min(m_minTop[i], m_children[i - 1].top) : m_children[i - 1].top;
+    }
+
+    // Appends the children that may intersect the vertical range [top, bottom],
+    // in the coordinates of the block, last child first.
+    void collect(int top, int bottom, Vector<RenderBox*, 16>& children) const
+    {
+        size_t begin = lower_bound(m_maxBottom.begin(), m_maxBottom.end(), top) - m_maxBottom.begin();
+        size_t end = upper_bound(m_minTop.begin(), m_minTop.end(), bottom) - m_minTop.begin();
+
+        size_t uncullable = m_uncullableChildren.size();
+        size_t i = end;
+        while (i > begin || uncullable) {
+            if (uncullable && (i <= begin || m_uncullableChildren[uncullable - 1].order > m_children[i - 1].order)) {
+                children.append(m_uncullableChildren[--uncullable].child);
+                continue;
+            }
+            const Entry& entry = m_children[--i];
+            if (entry.top <= bottom && entry.bottom >= top)
+                children.append(entry.child);
+        }
+    }
+
+private:
+    struct Entry {
+        Entry(RenderBox* box, unsigned treeOrder, int overflowTop, int overflowBottom)
+            : child(box)
+            , order(treeOrder)
+            , top(overflowTop)
+            , bottom(overflowBottom)
+        {
+        }
+
+        RenderBox* child;
+        unsigned order;
+        int top;
+        int bottom;
+    };
+
+    Vector<Entry> m_children;
+    Vector<Entry> m_uncullableChildren;
+    Vector<int> m_maxBottom;
+    Vector<int> m_minTop;
+};
+
+void RenderBlock::clearChildHitTestIndex()
+{
+    if (m_rareData)
+        m_rareData->m_childHitTestIndex.clear();
+}
+
+RenderBlock::ChildHitTestIndex* RenderBlock::childHitTestIndex()
+{
+    if (m_rareData && m_rareData->m_childHitTestIndex)
+        return m_rareData->m_childHitTestIndex.get();
+
+    // Children of flipped blocks are not hit tested at their own position,
+    // and a block that is waiting for layout has no positions worth keeping.
+    if (style()->isFlippedBlocksWritingMode() || needsLayout())
+        return 0;
+
+    unsigned childCount = 0;
+    for (RenderBox* child = firstChildBox(); child && childCount < ChildHitTestIndex::minimumChildCount; child = child->nextSiblingBox())
+        ++childCount;
+    if (childCount < ChildHitTestIndex::minimumChildCount)
+        return 0;
+
+    if (!m_rareData)
+        m_rareData = new RenderBlockRareData(this);
+    m_rareData->m_childHitTestIndex = adoptPtr(new ChildHitTestIndex(this));
+    return m_rareData->m_childHitTestIndex.get();
+}
+
 bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult& result, int x, int y, int tx, int ty, HitTestAction hitTestAction)
 {
     if (childrenInline() && !isTable()) {
@@ -4087,6 +4198,18 @@ bool RenderBlock::hitTestContents(const HitTestRequest& request, HitTestResult&
         HitTestAction childHitTest = hitTestAction;
         if (hitTestAction == HitTestChildBlockBackgrounds)
             childHitTest = HitTestChildBlockBackground;
+        if (ChildHitTestIndex* index = childHitTestIndex()) {
+            IntRect hitTestArea = result.rectForPoint(x, y);
+            Vector<RenderBox*, 16> children;
+            index->collect(hitTestArea.y() - ty, hitTestArea.maxY() - ty, children);
+            for (size_t i = 0; i < children.size(); ++i) {
+                RenderBox* child = children[i];
+                IntPoint childPoint = flipForWritingMode(child, IntPoint(tx, ty), ParentToChildFlippingAdjustment);
+                if (!child->hasSelfPaintingLayer() && !child->isFloating() && child->nodeAtPoint(request, result, x, y, childPoint.x(), childPoint.y(), childHitTest))
+                    return true;
+            }
+            return false;
+        }
         for (RenderBox* child = lastChildBox(); child; child = child->previousSiblingBox()) {
             IntPoint childPoint = flipForWritingMode(child, IntPoint(tx, ty), ParentToChildFlippingAdjustment);
             if (!child->hasSelfPaintingLayer() && !child->isFloating() && child->nodeAtPoint(request, result, x, y, childPoint.x(), childPoint.y(), childHitTest))
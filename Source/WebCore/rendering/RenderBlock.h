@@ -79,6 +79,10 @@ public:
 
     virtual void layoutBlock(bool relayoutChildren, int pageLogicalHeight = 0);
 
+    // Drops the index hitTestContents() keeps over our block children. Called
+    // whenever the children or their positions may have changed.
+    void clearChildHitTestIndex();
+
     void insertPositionedObject(RenderBox*);
     void removePositionedObject(RenderBox*);
     void removePositionedObjects(RenderBlock*);
@@ -553,6 +557,9 @@ private:
     virtual bool hitTestContents(const HitTestRequest&, HitTestResult&, int x, int y, int tx, int ty, HitTestAction);
     bool hitTestFloats(const HitTestRequest&, HitTestResult&, int x, int y, int tx, int ty);
 
+    class ChildHitTestIndex;
+    ChildHitTestIndex* childHitTestIndex();
+
     virtual bool isPointInOverflowControl(HitTestResult&, int x, int y, int tx, int ty);
 
     void computeInlinePreferredLogicalWidths();
@@ -778,6 +785,7 @@ private:
         MarginValues m_margins;
         int m_paginationStrut;
         int m_pageLogicalOffset;
+        OwnPtr<ChildHitTestIndex> m_childHitTestIndex;
      };
 
     OwnPtr<RenderBlockRareData> m_rareData;
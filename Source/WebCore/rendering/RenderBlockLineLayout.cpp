@@ -1448,6 +1448,10 @@ RootInlineBox* RenderBlock::determineEndPosition(RootInlineBox* startLine, Vecto
 bool RenderBlock::matchedEndLine(const InlineBidiResolver& resolver, const InlineIterator& endLineStart, const BidiStatus& endLineStatus, RootInlineBox*& endLine,
                                  int& endLogicalTop, int& repaintLogicalBottom, int& repaintLogicalTop)
 {
+    // All the clean lines may have been discarded by an earlier call.
+    if (!endLine)
+        return false;
+
     if (resolver.position() == endLineStart) {
         if (resolver.status() != endLineStatus)
             return false;
@@ -1476,6 +1480,21 @@ bool RenderBlock::matchedEndLine(const InlineBidiResolver& resolver, const Inlin
         return true;
     }
 
+    // Clean lines that break at a position the new lines have already moved past can never be
+    // matched, so throw them away. This keeps the window of lines checked below moving along
+    // with layout. Otherwise, once an edit near the top of a long paragraph makes the new line
+    // breaks drift more than a handful of lines from the old ones, the rest of the block would
+    // be laid out again even though its lines come back into sync further down.
+    RenderArena* arena = renderArena();
+    const InlineIterator& position = resolver.position();
+    while (endLine && endLine->lineBreakObj() == position.m_obj && endLine->lineBreakPos() < position.m_pos) {
+        repaintLogicalTop = min(repaintLogicalTop, endLine->logicalTopVisualOverflow());
+        repaintLogicalBottom = max(repaintLogicalBottom, endLine->logicalBottomVisualOverflow());
+        RootInlineBox* next = endLine->nextRootBox();
+        endLine->deleteLine(arena);
+        endLine = next;
+    }
+
     // The first clean line doesn't match, but we can check a handful of following lines to try
     // to match back up.
     static int numLines = 8; // The # of lines we're willing to match against.
@@ -1513,7 +1532,6 @@ bool RenderBlock::matchedEndLine(const InlineBidiResolver& resolver, const Inlin
 
             // Now delete the lines that we failed to sync.
             RootInlineBox* boxToDelete = endLine;
-            RenderArena* arena = renderArena();
             while (boxToDelete && boxToDelete != result) {
                 repaintLogicalTop = min(repaintLogicalTop, boxToDelete->logicalTopVisualOverflow());
                 repaintLogicalBottom = max(repaintLogicalBottom, boxToDelete->logicalBottomVisualOverflow());
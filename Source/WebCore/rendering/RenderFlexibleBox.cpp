@@ -214,6 +214,10 @@ void RenderFlexibleBox::layoutBlock(bool relayoutChildren, int /*pageHeight FIXM
 {
     ASSERT(needsLayout());
 
+    clearChildHitTestIndex();
+    if (parent() && parent()->isRenderBlock())
+        toRenderBlock(parent())->clearChildHitTestIndex();
+
     if (!relayoutChildren && simplifiedLayout())
         return;
 
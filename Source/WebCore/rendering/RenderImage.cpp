@@ -27,7 +27,9 @@
 #include "config.h"
 #include "RenderImage.h"
 
+#include "CachedImage.h"
 #include "Frame.h"
+#include "FrameView.h"
 #include "GraphicsContext.h"
 #include "HTMLAreaElement.h"
 #include "HTMLImageElement.h"
@@ -139,6 +141,10 @@ void RenderImage::imageChanged(WrappedImagePtr newImage, const IntRect* rect)
     if (documentBeingDestroyed())
         return;
 
+#ifdef ANDROID_INSTRUMENT
+    LayoutProfiler::CauseScope layoutCause(LayoutProfiler::ResourceLoad);
+#endif
+
     if (hasBoxDecorations() || hasMask())
         RenderReplaced::imageChanged(newImage, rect);
     
@@ -238,8 +244,25 @@ void RenderImage::notifyFinished(CachedResource* newImage)
 #endif
 }
 
+void RenderImage::raiseLoadPriorityIfVisible()
+{
+    // Images that turn out to be on screen are loaded ahead of those that
+    // are not. Images already being loaded keep their priority.
+    CachedImage* image = cachedImage();
+    if (!image || !image->isLoading() || image->loadPriority() >= ResourceLoadPriorityMedium)
+        return;
+    FrameView* frameView = view() ? view()->frameView() : 0;
+    if (frameView && absoluteContentBox().intersects(frameView->visibleContentRect()))
+        image->setLoadPriority(ResourceLoadPriorityMedium);
+}
+
 void RenderImage::paintReplaced(PaintInfo& paintInfo, int tx, int ty)
 {
+    // Only once the image paints has its line box placed it, so this is the
+    // first point where its position on screen can be trusted.
+    if (paintInfo.phase == PaintPhaseForeground)
+        raiseLoadPriorityIfVisible();
+
     int cWidth = contentWidth();
     int cHeight = contentHeight();
     int leftBorder = borderLeft();
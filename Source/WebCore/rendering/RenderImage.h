@@ -77,6 +77,7 @@ private:
     virtual bool isRenderImage() const { return true; }
 
     virtual void paintReplaced(PaintInfo&, int tx, int ty);
+    void raiseLoadPriorityIfVisible();
 
     virtual int minimumReplacedHeight() const;
 
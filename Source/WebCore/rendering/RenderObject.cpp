@@ -578,6 +578,8 @@ void RenderObject::setPreferredLogicalWidthsDirty(bool b, bool markParents)
 {
     bool alreadyDirty = m_preferredLogicalWidthsDirty;
     m_preferredLogicalWidthsDirty = b;
+    if (b && isTable())
+        toRenderTable(this)->preferredLogicalWidthsDirtiedBy(this);
     if (b && !alreadyDirty && markParents && (isText() || (style()->position() != FixedPosition && style()->position() != AbsolutePosition)))
         invalidateContainerPreferredLogicalWidths();
 }
@@ -586,8 +588,15 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
 {
     // In order to avoid pathological behavior when inlines are deeply nested, we do include them
     // in the chain that we mark dirty (even though they're kind of irrelevant).
+    RenderObject* child = this;
     RenderObject* o = isTableCell() ? containingBlock() : container();
-    while (o && !o->m_preferredLogicalWidthsDirty) {
+    while (o) {
+        // Tables want to know which cell changed even when they are already dirty.
+        if (o->isTable())
+            toRenderTable(o)->preferredLogicalWidthsDirtiedBy(child);
+        if (o->m_preferredLogicalWidthsDirty)
+            break;
+
         // Don't invalidate the outermost object of an unrooted subtree. That object will be 
         // invalidated when the subtree is added to the document.
         RenderObject* container = o->isTableCell() ? o->containingBlock() : o->container();
@@ -599,6 +608,7 @@ void RenderObject::invalidateContainerPreferredLogicalWidths()
             // A positioned object has no effect on the min/max width of its containing block ever.
             // We can optimize this case and not go up any further.
             break;
+        child = o;
         o = container;
     }
 }
@@ -37,6 +37,10 @@
 #include "TransformationMatrix.h"
 #include <wtf/UnusedParam.h>
 
+#ifdef ANDROID_INSTRUMENT
+#include "LayoutProfiler.h"
+#endif
+
 #if USE(CG) || USE(CAIRO) || PLATFORM(QT)
 #define HAVE_PATH_BASED_BORDER_RADIUS_DRAWING 1
 #endif
@@ -519,7 +523,15 @@ public:
     virtual void layout();
 
     /* This function performs a layout only if one is needed. */
-    void layoutIfNeeded() { if (needsLayout()) layout(); }
+    void layoutIfNeeded()
+    {
+        if (!needsLayout())
+            return;
+#ifdef ANDROID_INSTRUMENT
+        LayoutProfiler::Scope profilerScope(this);
+#endif
+        layout();
+    }
     
     // used for element state updates that cannot be fixed with a
     // repaint and do not need a relayout
@@ -924,6 +936,10 @@ inline void RenderObject::setNeedsLayout(bool b, bool markParents)
     if (b) {
         ASSERT(!isSetNeedsLayoutForbidden());
         if (!alreadyNeededLayout) {
+#ifdef ANDROID_INSTRUMENT
+            if (LayoutProfiler::isEnabled())
+                LayoutProfiler::didMarkNeedsLayout(this);
+#endif
             if (markParents)
                 markContainingBlocksForLayout();
             if (hasLayer())
@@ -63,8 +63,14 @@ void RenderObjectChildList::destroyLeftoverChildren()
 
 RenderObject* RenderObjectChildList::removeChildNode(RenderObject* owner, RenderObject* oldChild, bool fullRemove)
 {
+#ifdef ANDROID_INSTRUMENT
+    LayoutProfiler::CauseScope layoutCause(LayoutProfiler::TreeChange);
+#endif
     ASSERT(oldChild->parent() == owner);
 
+    if (owner->isRenderBlock())
+        toRenderBlock(owner)->clearChildHitTestIndex();
+
     // So that we'll get the appropriate dirty bit set (either that a normal flow child got yanked or
     // that a positioned child got yanked).  We also repaint, so that the area exposed when the child
     // disappears gets repainted properly.
@@ -140,9 +146,15 @@ RenderObject* RenderObjectChildList::removeChildNode(RenderObject* owner, Render
 
 void RenderObjectChildList::appendChildNode(RenderObject* owner, RenderObject* newChild, bool fullAppend)
 {
+#ifdef ANDROID_INSTRUMENT
+    LayoutProfiler::CauseScope layoutCause(LayoutProfiler::TreeChange);
+#endif
     ASSERT(newChild->parent() == 0);
     ASSERT(!owner->isBlockFlow() || (!newChild->isTableSection() && !newChild->isTableRow() && !newChild->isTableCell()));
 
+    if (owner->isRenderBlock())
+        toRenderBlock(owner)->clearChildHitTestIndex();
+
     newChild->setParent(owner);
     RenderObject* lChild = lastChild();
 
@@ -190,6 +202,9 @@ void RenderObjectChildList::appendChildNode(RenderObject* owner, RenderObject* n
 
 void RenderObjectChildList::insertChildNode(RenderObject* owner, RenderObject* child, RenderObject* beforeChild, bool fullInsert)
 {
+#ifdef ANDROID_INSTRUMENT
+    LayoutProfiler::CauseScope layoutCause(LayoutProfiler::TreeChange);
+#endif
     if (!beforeChild) {
         appendChildNode(owner, child, fullInsert);
         return;
@@ -202,6 +217,9 @@ void RenderObjectChildList::insertChildNode(RenderObject* owner, RenderObject* c
 
     ASSERT(!owner->isBlockFlow() || (!child->isTableSection() && !child->isTableRow() && !child->isTableCell()));
 
+    if (owner->isRenderBlock())
+        toRenderBlock(owner)->clearChildHitTestIndex();
+
     if (beforeChild == firstChild())
         setFirstChild(child);
 
@@ -658,6 +658,16 @@ void RenderTable::computePreferredLogicalWidths()
     setPreferredLogicalWidthsDirty(false);
 }
 
+void RenderTable::preferredLogicalWidthsDirtiedBy(RenderObject* object)
+{
+    if (!m_tableLayout)
+        return;
+    if (object->isTableCell())
+        m_tableLayout->cellPreferredLogicalWidthsChanged(toRenderTableCell(object));
+    else
+        m_tableLayout->setNeedsFullRecalc();
+}
+
 void RenderTable::splitColumn(int pos, int firstSpan)
 {
     // we need to add a new columnStruct
@@ -771,6 +781,9 @@ void RenderTable::recalcCaption(RenderBlock* caption) const
 
 void RenderTable::recalcSections() const
 {
+    if (m_tableLayout)
+        m_tableLayout->setNeedsFullRecalc();
+
     m_caption = 0;
     m_head = 0;
     m_foot = 0;
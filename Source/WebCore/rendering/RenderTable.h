@@ -175,6 +175,9 @@ public:
     RenderTableCol* colElement(int col, bool* startEdge = 0, bool* endEdge = 0) const;
     RenderTableCol* nextColElement(RenderTableCol* current) const;
 
+    // Tells the table layout which cell, if any, made our preferred widths dirty.
+    void preferredLogicalWidthsDirtiedBy(RenderObject*);
+
     bool needsSectionRecalc() const { return m_needsSectionRecalc; }
     void setNeedsSectionRecalc()
     {
@@ -1163,6 +1163,10 @@ void RenderText::setText(PassRefPtr<StringImpl> text, bool force)
     if (!force && equal(m_text.impl(), text.get()))
         return;
 
+#ifdef ANDROID_INSTRUMENT
+    LayoutProfiler::CauseScope layoutCause(LayoutProfiler::TextChange);
+#endif
+
     setTextInternal(text);
     setNeedsLayoutAndPrefWidthsRecalc();
     m_knownToHaveNoOverflowAndNoFallbackFonts = false;
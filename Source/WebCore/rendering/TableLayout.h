@@ -27,6 +27,7 @@
 namespace WebCore {
 
 class RenderTable;
+class RenderTableCell;
 
 class TableLayout {
     WTF_MAKE_NONCOPYABLE(TableLayout); WTF_MAKE_FAST_ALLOCATED;
@@ -41,6 +42,11 @@ public:
     virtual void computePreferredLogicalWidths(int& minWidth, int& maxWidth) = 0;
     virtual void layout() = 0;
 
+    // Called when the preferred widths of the table become dirty. Layouts that
+    // keep per column results can use these to recompute only what changed.
+    virtual void cellPreferredLogicalWidthsChanged(RenderTableCell*) { }
+    virtual void setNeedsFullRecalc() { }
+
 protected:
     RenderTable* m_table;
 };
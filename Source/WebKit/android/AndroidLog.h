@@ -44,5 +44,6 @@ extern FILE* gRenderTreeFile;
 
 #define DISPLAY_TREE_LOG_FILE "/sdcard/displayTree.txt"
 #define LAYERS_TREE_LOG_FILE "/sdcard/layersTree.plist"
+#define LAYOUT_PROFILE_LOG_FILE "/sdcard/layoutProfile.json"
 
 #endif // AndroidLog_h
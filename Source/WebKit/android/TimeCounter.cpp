@@ -31,6 +31,8 @@
 #include "MemoryCache.h"
 #include "KURL.h"
 #include "Node.h"
+#include "RenderArena.h"
+#include "WidthCache.h"
 #include "SystemTime.h"
 #include "StyleBase.h"
 #include <sys/time.h>
@@ -119,7 +121,7 @@ void TimeCounter::recordNoCounter(enum Type type, const char* functionName)
         LOGW("***** %s() used %d ms\n", functionName, elapsed);
 }
 
-void TimeCounter::report(const KURL& url, int live, int dead, size_t arenaSize)
+void TimeCounter::report(const KURL& url, int live, int dead, const RenderArena* arena)
 {
     String urlString = url;
     int totalTime = static_cast<int>((currentTime() - sStartTotalTime) * 1000);
@@ -136,7 +138,8 @@ void TimeCounter::report(const KURL& url, int live, int dead, size_t arenaSize)
         LOGD("%s", scratch);
     }
     LOGD("Current cache has %d bytes live and %d bytes dead", live, dead);
-    LOGD("Current render arena takes %d bytes", arenaSize);
+    LOGD("Current render arena takes %d bytes", arena->reportPoolSize());
+    arena->reportSizeClasses();
 #if USE(JSC)
     JSLock lock(false);
     Heap::Statistics jsHeapStatistics = JSDOMWindow::commonJSGlobalData()->heap.statistics();
@@ -145,6 +148,7 @@ void TimeCounter::report(const KURL& url, int live, int dead, size_t arenaSize)
 #endif
     LOGD("Current CSS styles use %d bytes", StyleBase::reportStyleSize());
     LOGD("Current DOM nodes use %d bytes", WebCore::Node::reportDOMNodesSize());
+    LOGD("Text width caches had %u hits and %u misses", WidthCache::totalHits(), WidthCache::totalMisses());
 }
 
 void TimeCounter::reportNow()
@@ -31,6 +31,7 @@
 namespace WebCore {
 
 class KURL;
+class RenderArena;
 
 }
 
@@ -66,7 +67,7 @@ public:
 
     static void record(enum Type type, const char* functionName);
     static void recordNoCounter(enum Type type, const char* functionName);
-    static void report(const WebCore::KURL& , int live, int dead, size_t arenaSize);
+    static void report(const WebCore::KURL& , int live, int dead, const WebCore::RenderArena*);
     static void reportNow();
     static void reset();
     static void start(enum Type type);
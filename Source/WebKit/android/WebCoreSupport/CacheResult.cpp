@@ -49,8 +49,9 @@ enum {
     kResponseContentIndex
 };
 
-CacheResult::CacheResult(disk_cache::Entry* entry, String url)
+CacheResult::CacheResult(disk_cache::Entry* entry, String url, scoped_refptr<HttpResponseHeaders> responseHeaders)
     : m_entry(entry)
+    , m_responseHeaders(responseHeaders)
     , m_onResponseHeadersDoneCallback(this, &CacheResult::onResponseHeadersDone)
     , m_onReadNextChunkDoneCallback(this, &CacheResult::onReadNextChunkDone)
     , m_url(url)
@@ -37,8 +37,9 @@ namespace android {
 // A wrapper around a disk_cache::Entry. Provides fields appropriate for constructing a Java CacheResult object.
 class CacheResult : public base::RefCountedThreadSafe<CacheResult> {
 public:
-    // Takes ownership of the Entry passed to the constructor.
-    CacheResult(disk_cache::Entry*, String url);
+    // Takes ownership of the Entry passed to the constructor. Headers already
+    // parsed from the entry, if any, save reading them again.
+    CacheResult(disk_cache::Entry*, String url, scoped_refptr<net::HttpResponseHeaders> = 0);
     ~CacheResult();
 
     int64 contentSize() const;
@@ -50,8 +51,8 @@ public:
     int64 expires() const;
     int responseCode() const;
     bool writeToFile(const WTF::String& filePath) const;
-private:
     net::HttpResponseHeaders* responseHeaders() const;
+private:
     void responseHeadersImpl();
     void onResponseHeadersDone(int size);
 
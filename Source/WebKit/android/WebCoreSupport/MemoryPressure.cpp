@@ -0,0 +1,198 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define LOG_TAG "MemoryPressure"
+#include "config.h"
+#include "MemoryPressure.h"
+
+#include "FontCache.h"
+#include "MemoryCache.h"
+#include "PageCache.h"
+#include "RenderArena.h"
+#include "SkGraphics.h"
+#include "TilesManager.h"
+
+#include <algorithm>
+#include <malloc.h>
+#include <utils/Log.h>
+#include <wtf/MainThread.h>
+#include <wtf/StdLibExtras.h>
+
+#if USE(JSC)
+#include "GCController.h"
+#include "JSDOMWindow.h"
+#include <runtime/JSLock.h>
+#include <runtime/RegExpCache.h>
+#elif USE(V8)
+#include <v8.h>
+#endif
+
+using namespace WebCore;
+
+namespace android {
+
+namespace {
+
+// Each step returns the bytes it knows it freed, or 0 if the cache does not
+// keep count. The heap is measured around every step either way.
+typedef size_t (*PurgeFunction)(int level);
+
+size_t purgeDecodedImages(int)
+{
+    return memoryCache()->destroyDeadDecodedData();
+}
+
+size_t purgePageCache(int level)
+{
+    // Until the process is in real danger, keep the pages but drop their
+    // render trees; going back then only costs a layout.
+    PageCache* cache = pageCache();
+    if (level < MemoryPressure::ModerateLevel) {
+        int renderedCapacity = cache->renderedCapacity();
+        cache->setRenderedCapacity(0);
+        cache->setRenderedCapacity(renderedCapacity);
+        return 0;
+    }
+    int capacity = cache->capacity();
+    cache->setCapacity(0);
+    cache->releaseAutoreleasedPagesNow();
+    cache->setCapacity(capacity);
+    return 0;
+}
+
+size_t releaseRenderArenaSlabs(int)
+{
+    return RenderArena::releaseFreeSlabs();
+}
+
+size_t purgeInactiveFonts(int)
+{
+    // Also prunes the glyph pages of the fonts it drops.
+    fontCache()->purgeInactiveFontData();
+    return 0;
+}
+
+size_t purgeGlyphCache(int)
+{
+    size_t used = SkGraphics::GetFontCacheUsed();
+    SkGraphics::SetFontCacheUsed(0);
+    return used - std::min(used, SkGraphics::GetFontCacheUsed());
+}
+
+size_t purgeRegExpCache(int)
+{
+#if USE(JSC)
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    JSDOMWindow::commonJSGlobalData()->regExpCache()->clear();
+#endif
+    return 0;
+}
+
+size_t evictUnusedResources(int)
+{
+    return memoryCache()->evictDeadResources();
+}
+
+size_t collectGarbage(int)
+{
+#if USE(JSC)
+    JSC::JSLock lock(JSC::SilenceAssertionsOnly);
+    JSC::Heap& heap = JSDOMWindow::commonJSGlobalData()->heap;
+    size_t size = heap.size();
+    gcController().garbageCollectNow();
+    return size - std::min(size, heap.size());
+#else
+#if USE(V8)
+    v8::V8::LowMemoryNotification();
+#endif
+    return 0;
+#endif
+}
+
+struct PurgeStep {
+    const char* name;
+    int level; // The lowest level the step runs at.
+    PurgeFunction purge;
+};
+
+// In the order of what they cost to rebuild. Tile textures are freed by
+// onTrimMemory() on the UI thread.
+const PurgeStep purgeSteps[] = {
+    { "decoded images", MemoryPressure::UIHiddenLevel, purgeDecodedImages },
+    { "page cache", MemoryPressure::BackgroundLevel, purgePageCache },
+    // After the page cache, whose render trees leave empty slabs behind.
+    { "render arena slabs", MemoryPressure::UIHiddenLevel, releaseRenderArenaSlabs },
+    { "inactive fonts", MemoryPressure::BackgroundLevel, purgeInactiveFonts },
+    { "glyph cache", MemoryPressure::BackgroundLevel, purgeGlyphCache },
+    { "regexp cache", MemoryPressure::BackgroundLevel, purgeRegExpCache },
+    { "unused resources", MemoryPressure::ModerateLevel, evictUnusedResources },
+    { "javascript heap", MemoryPressure::ModerateLevel, collectGarbage },
+};
+
+size_t heapInUse()
+{
+    struct mallinfo info = mallinfo();
+    return info.uordblks + info.hblkhd;
+}
+
+void purgeOnMainThread(void* context)
+{
+    MemoryPressure::purge(reinterpret_cast<intptr_t>(context));
+}
+
+} // namespace
+
+void MemoryPressure::onTrimMemory(int level)
+{
+    if (TilesManager::hardwareAccelerationEnabled()) {
+        // Once hidden, only the textures of what was last on screen are kept.
+        bool allTextures = level > UIHiddenLevel;
+        int textures = TilesManager::instance()->deallocateTextures(allTextures);
+        size_t textureBytes = static_cast<size_t>(TilesManager::tileWidth() * TilesManager::tileHeight()) * 4;
+        LOGD("Level %d: tile textures freed about %u bytes", level, textures * textureBytes);
+    }
+    callOnMainThread(purgeOnMainThread, reinterpret_cast<void*>(level));
+}
+
+size_t MemoryPressure::purge(int level)
+{
+    ASSERT(isMainThread());
+    size_t total = 0;
+    for (size_t i = 0; i < WTF_ARRAY_LENGTH(purgeSteps); ++i) {
+        const PurgeStep& step = purgeSteps[i];
+        if (level < step.level)
+            continue;
+        size_t heapBefore = heapInUse();
+        size_t freed = step.purge(level);
+        size_t heapAfter = heapInUse();
+        size_t heapFreed = heapBefore - std::min(heapBefore, heapAfter);
+        LOGD("Level %d: %s freed %u bytes, heap shrank by %u bytes", level, step.name, freed, heapFreed);
+        total += std::max(freed, heapFreed);
+    }
+    LOGD("Level %d: reclaimed %u bytes", level, total);
+    return total;
+}
+
+} // namespace android
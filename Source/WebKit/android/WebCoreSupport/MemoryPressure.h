@@ -0,0 +1,59 @@
+/*
+ * Copyright 2011, The Android Open Source Project
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MemoryPressure_h
+#define MemoryPressure_h
+
+#include <stddef.h>
+
+namespace android {
+
+// Frees memory across WebCore's caches when the system runs low, cheapest to
+// rebuild first: decoded images, cached pages, inactive fonts, glyphs, compiled
+// regular expressions, tile textures, unused resources and finally the
+// JavaScript heap. How far down the list it goes depends on the level, and
+// each step logs the bytes it reclaimed.
+class MemoryPressure {
+public:
+    // The levels of ComponentCallbacks2.onTrimMemory().
+    enum Level {
+        UIHiddenLevel = 20, // The WebView is no longer visible.
+        BackgroundLevel = 40, // The process is in the background.
+        ModerateLevel = 60, // The process is halfway down the list of those to kill.
+        CompleteLevel = 80 // The process is next to be killed.
+    };
+
+    // Called on the UI thread. Frees tile textures there, since the GL context
+    // lives on that thread, and schedules purge() on the WebCore thread.
+    static void onTrimMemory(int level);
+
+    // Frees what |level| calls for and returns the number of bytes reclaimed.
+    // Must be called on the WebCore thread.
+    static size_t purge(int level);
+};
+
+} // namespace android
+
+#endif // MemoryPressure_h
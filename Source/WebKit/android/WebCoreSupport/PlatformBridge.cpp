@@ -36,6 +36,7 @@
 #include "MemoryUsage.h"
 #include "PluginView.h"
 #include "Settings.h"
+#include "WebCache.h"
 #include "WebCookieJar.h"
 #include "WebRequestContext.h"
 #include "WebViewCore.h"
@@ -90,7 +91,7 @@ String PlatformBridge::cookies(const Document* document, const KURL& url)
 #if USE(CHROME_NETWORK_STACK)
     GURL cookieGurl(url.string().utf8().data());
     bool isPrivateBrowsing = document->settings() && document->settings()->privateBrowsingEnabled();
-    std::string cookies = WebCookieJar::get(isPrivateBrowsing)->cookieStore()->GetCookies(cookieGurl);
+    std::string cookies = WebCookieJar::get(isPrivateBrowsing)->cookies(cookieGurl);
     String cookieString(cookies.c_str());
     return cookieString;
 #else
@@ -116,6 +117,15 @@ bool PlatformBridge::cookiesEnabled(const Document* document)
 #endif
 }
 
+void PlatformBridge::prefetchDNS(const String& hostname)
+{
+#if USE(CHROME_NETWORK_STACK)
+    // Document::isDNSPrefetchEnabled() and HTMLLinkElement drop hints while
+    // browsing privately, so the regular cache's resolver is the one to warm up.
+    WebCache::get(false)->prefetchHost(std::string(hostname.utf8().data()));
+#endif
+}
+
 NPObject* PlatformBridge::pluginScriptableObject(Widget* widget)
 {
 #if USE(V8)
@@ -46,6 +46,38 @@ namespace android {
 
 static WTF::Mutex instanceMutex;
 
+namespace {
+
+// A speculative lookup. The resolver keeps the answer in its host cache, so
+// the request only has to stay alive until the lookup is done.
+class HostPrefetchRequest {
+public:
+    HostPrefetchRequest()
+        : m_callback(this, &HostPrefetchRequest::onResolved)
+    {
+    }
+
+    void start(HostResolver* resolver, const string& host)
+    {
+        HostResolver::RequestInfo info(HostPortPair(host, 80));
+        info.set_priority(LOWEST);
+        info.set_is_speculative(true);
+        if (resolver->Resolve(info, &m_addresses, &m_callback, 0, BoundNetLog()) != ERR_IO_PENDING)
+            delete this;
+    }
+
+private:
+    void onResolved(int)
+    {
+        delete this;
+    }
+
+    AddressList m_addresses;
+    CompletionCallbackImpl<HostPrefetchRequest> m_callback;
+};
+
+} // namespace
+
 static string storageDirectory()
 {
     static const char* const kDirectory = "/webviewCacheChromium";
@@ -92,8 +124,9 @@ WebCache::WebCache(bool isPrivateBrowsing)
     , m_onClearDoneCallback(this, &WebCache::onClearDone)
     , m_isClearInProgress(false)
     , m_openEntryCallback(this, &WebCache::openEntry)
-    , m_onGetEntryDoneCallback(this, &WebCache::onGetEntryDone)
     , m_isGetEntryInProgress(false)
+    , m_nextEntry(0)
+    , m_headersIndexGeneration(0)
     , m_cacheBackend(0)
 {
     base::Thread* ioThread = WebUrlLoaderClient::ioThread();
@@ -133,6 +166,12 @@ WebCache::WebCache(bool isPrivateBrowsing)
 
 void WebCache::clear()
 {
+    {
+        MutexLocker lock(m_headersIndexMutex);
+        m_headersIndex.clear();
+        ++m_headersIndexGeneration;
+    }
+
     base::Thread* thread = WebUrlLoaderClient::ioThread();
     if (thread)
         thread->message_loop()->PostTask(FROM_HERE, NewRunnableMethod(this, &WebCache::clearImpl));
@@ -150,6 +189,20 @@ void WebCache::closeIdleImpl()
     m_cache->CloseIdleConnections();
 }
 
+void WebCache::prefetchHost(const string& host)
+{
+    base::Thread* thread = WebUrlLoaderClient::ioThread();
+    if (thread)
+        thread->message_loop()->PostTask(FROM_HERE, NewRunnableMethod(this, &WebCache::prefetchHostImpl, host));
+}
+
+void WebCache::prefetchHostImpl(string host)
+{
+    // Deletes itself once the lookup completes.
+    HostPrefetchRequest* request = new HostPrefetchRequest();
+    request->start(m_hostResolver.get(), host);
+}
+
 void WebCache::clearImpl()
 {
     if (m_isClearInProgress)
@@ -190,31 +243,119 @@ void WebCache::onClearDone(int)
 }
 
 scoped_refptr<CacheResult> WebCache::getCacheResult(String url)
+{
+    Vector<String> urls;
+    urls.append(url);
+    Vector<scoped_refptr<CacheResult> > results;
+    getCacheResults(urls, results);
+    return results[0];
+}
+
+void WebCache::getCacheResults(const Vector<String>& urls, Vector<scoped_refptr<CacheResult> >& results)
 {
     // This is called on the UI thread.
-    MutexLocker lock(m_getEntryMutex);
-    if (m_isGetEntryInProgress)
-        return 0; // TODO: OK? Or can we queue 'em up?
+    results.clear();
+    results.resize(urls.size());
+
+    Vector<std::string> keys;
+    Vector<scoped_refptr<HttpResponseHeaders> > headers;
+    unsigned generation;
+    {
+        MutexLocker lock(m_headersIndexMutex);
+        for (size_t i = 0; i < urls.size(); ++i) {
+            keys.append(cacheKey(GURL(urls[i].utf8().data())));
+            headers.append(findResponseHeaders(keys[i]));
+        }
+        generation = m_headersIndexGeneration;
+    }
 
-    // The Chromium methods are asynchronous, but we need this method to be
-    // synchronous. Do the work on the Chromium thread but block this thread
-    // here waiting for the work to complete.
-    base::Thread* thread = WebUrlLoaderClient::ioThread();
-    if (!thread)
-        return 0;
+    // Every entry is opened afresh, so one the backend has doomed or evicted
+    // since it was last looked up is simply not found.
+    Vector<disk_cache::Entry*> entries;
+    {
+        MutexLocker lock(m_getEntryMutex);
+        if (m_isGetEntryInProgress)
+            return; // TODO: OK? Or can we queue 'em up?
+
+        // The Chromium methods are asynchronous, but we need this method to be
+        // synchronous. Do the work on the Chromium thread but block this thread
+        // here waiting for the work to complete.
+        base::Thread* thread = WebUrlLoaderClient::ioThread();
+        if (!thread)
+            return;
 
-    m_entry = 0;
-    m_isGetEntryInProgress = true;
-    m_entryUrl = url.threadsafeCopy();
-    thread->message_loop()->PostTask(FROM_HERE, NewRunnableMethod(this, &WebCache::getEntryImpl));
+        m_entryKeys = keys;
+        m_entries.fill(0, keys.size());
+        m_nextEntry = 0;
+        m_isGetEntryInProgress = true;
+        thread->message_loop()->PostTask(FROM_HERE, NewRunnableMethod(this, &WebCache::getEntryImpl));
 
-    while (m_isGetEntryInProgress)
-        m_getEntryCondition.wait(m_getEntryMutex);
+        while (m_isGetEntryInProgress)
+            m_getEntryCondition.wait(m_getEntryMutex);
+        entries.swap(m_entries);
+    }
 
-    if (!m_entry)
-        return 0;
+    for (size_t i = 0; i < urls.size(); ++i) {
+        if (!entries[i])
+            continue;
+        results[i] = new CacheResult(entries[i], urls[i], headers[i]);
+        if (headers[i])
+            continue;
+
+        // The caller always asks for the headers, so read them now while we
+        // can remember them for the next lookup.
+        scoped_refptr<HttpResponseHeaders> responseHeaders = results[i]->responseHeaders();
+        MutexLocker lock(m_headersIndexMutex);
+        if (responseHeaders && generation == m_headersIndexGeneration)
+            addResponseHeaders(keys[i], responseHeaders);
+    }
+}
 
-    return new CacheResult(m_entry, url);
+string WebCache::cacheKey(const GURL& url)
+{
+    GURL::Replacements replacements;
+    replacements.ClearRef();
+    return url.ReplaceComponents(replacements).spec();
+}
+
+void WebCache::invalidateCacheResult(const GURL& url)
+{
+    string key = cacheKey(url);
+    MutexLocker lock(m_headersIndexMutex);
+    ++m_headersIndexGeneration;
+    for (size_t i = 0; i < m_headersIndex.size(); ++i) {
+        if (m_headersIndex[i].key == key) {
+            m_headersIndex.remove(i);
+            return;
+        }
+    }
+}
+
+// Called with m_headersIndexMutex held.
+scoped_refptr<HttpResponseHeaders> WebCache::findResponseHeaders(const string& key)
+{
+    for (size_t i = 0; i < m_headersIndex.size(); ++i) {
+        if (m_headersIndex[i].key != key)
+            continue;
+        IndexedHeaders found = m_headersIndex[i];
+        m_headersIndex.remove(i);
+        m_headersIndex.append(found);
+        return found.headers;
+    }
+    return 0;
+}
+
+// Called with m_headersIndexMutex held.
+void WebCache::addResponseHeaders(const string& key, scoped_refptr<HttpResponseHeaders> headers)
+{
+    // Small enough to search linearly.
+    static const size_t kMaxIndexedHeaders = 32;
+    if (m_headersIndex.size() >= kMaxIndexedHeaders)
+        m_headersIndex.remove(0);
+    IndexedHeaders indexed;
+    indexed.key = key;
+    indexed.headers = headers;
+    m_headersIndex.append(indexed);
 }
 
 void WebCache::getEntryImpl()
@@ -224,28 +365,33 @@ void WebCache::getEntryImpl()
         if (code == ERR_IO_PENDING)
             return;
         else if (code != OK) {
-            onGetEntryDone(0 /*unused*/);
+            onGetEntryDone();
             return;
         }
     }
     openEntry(0 /*unused*/);
 }
 
+// Opens the entries one after the other. Each one that completes
+// asynchronously calls back in here to continue with the next.
 void WebCache::openEntry(int)
 {
     if (!m_cacheBackend) {
-        onGetEntryDone(0 /*unused*/);
+        onGetEntryDone();
         return;
     }
 
-    if (m_cacheBackend->OpenEntry(string(m_entryUrl.utf8().data()), &m_entry, &m_onGetEntryDoneCallback) == ERR_IO_PENDING)
-        return;
-    onGetEntryDone(0 /*unused*/);
+    while (m_nextEntry < m_entryKeys.size()) {
+        size_t index = m_nextEntry++;
+        if (m_cacheBackend->OpenEntry(m_entryKeys[index], &m_entries[index], &m_openEntryCallback) == ERR_IO_PENDING)
+            return;
+    }
+    onGetEntryDone();
 }
 
-void WebCache::onGetEntryDone(int)
+void WebCache::onGetEntryDone()
 {
-    // Unblock the UI thread in getEntry();
+    // Unblock the UI thread in getCacheResults();
     MutexLocker lock(m_getEntryMutex);
     m_isGetEntryInProgress = false;
     m_getEntryCondition.signal();
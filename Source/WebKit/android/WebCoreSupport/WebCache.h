@@ -33,6 +33,7 @@
 #include <OwnPtr.h>
 #include <platform/text/PlatformString.h>
 #include <wtf/ThreadingPrimitives.h>
+#include <wtf/Vector.h>
 
 namespace android {
 
@@ -45,10 +46,21 @@ public:
 
     void clear();
     scoped_refptr<CacheResult> getCacheResult(WTF::String url);
+    // Looks up many urls with a single trip to the IO thread. |results| gets
+    // one entry per url, null for those not in the cache.
+    void getCacheResults(const Vector<WTF::String>& urls, Vector<scoped_refptr<CacheResult> >& results);
+    // Drops the response headers remembered for |url|, whose entry the cache
+    // may have just written. Can be called from any thread.
+    void invalidateCacheResult(const GURL& url);
+    // The key of |url| in the disk cache, which ignores the ref.
+    static std::string cacheKey(const GURL& url);
     net::HostResolver* hostResolver() { return m_hostResolver.get(); }
     net::HttpCache* cache() { return m_cache.get(); }
     net::ProxyConfigServiceAndroid* proxy() { return m_proxyConfigService; }
     void closeIdleConnections();
+    // Resolves |host| on the IO thread so that a load that needs it soon finds
+    // the address in the host cache. Can be called from any thread.
+    void prefetchHost(const std::string& host);
 
 
 private:
@@ -62,10 +74,15 @@ private:
     // For closeIdleConnections
     void closeIdleImpl();
 
-    // For getEntry()
+    // For prefetchHost()
+    void prefetchHostImpl(std::string host);
+
+    // For getCacheResults()
     void getEntryImpl();
     void openEntry(int);
-    void onGetEntryDone(int);
+    void onGetEntryDone();
+    scoped_refptr<net::HttpResponseHeaders> findResponseHeaders(const std::string& key);
+    void addResponseHeaders(const std::string& key, scoped_refptr<net::HttpResponseHeaders>);
 
     OwnPtr<net::HostResolver> m_hostResolver;
     OwnPtr<net::HostResolver::HostnameResolverExt> m_hostPreresolver;
@@ -78,15 +95,29 @@ private:
     net::CompletionCallbackImpl<WebCache> m_doomAllEntriesCallback;
     net::CompletionCallbackImpl<WebCache> m_onClearDoneCallback;
     bool m_isClearInProgress;
-    // For getEntry()
+    // For getCacheResults()
     net::CompletionCallbackImpl<WebCache> m_openEntryCallback;
-    net::CompletionCallbackImpl<WebCache> m_onGetEntryDoneCallback;
     bool m_isGetEntryInProgress;
-    String m_entryUrl;
-    disk_cache::Entry* m_entry;
+    Vector<std::string> m_entryKeys;
+    Vector<disk_cache::Entry*> m_entries;
+    size_t m_nextEntry;
     WTF::Mutex m_getEntryMutex;
     WTF::ThreadCondition m_getEntryCondition;
 
+    // The parsed response headers of the most recently looked up urls, most
+    // recent last. Only the headers are kept: the entry itself is opened
+    // afresh on every lookup, so one the backend has doomed or evicted since
+    // is simply not found.
+    struct IndexedHeaders {
+        std::string key;
+        scoped_refptr<net::HttpResponseHeaders> headers;
+    };
+    Vector<IndexedHeaders> m_headersIndex;
+    // Bumped on every invalidation, so that a lookup that raced with a write
+    // does not remember what it read.
+    unsigned m_headersIndexGeneration;
+    WTF::Mutex m_headersIndexMutex;
+
     disk_cache::Backend* m_cacheBackend;
 };
 
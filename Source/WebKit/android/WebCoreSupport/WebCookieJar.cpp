@@ -33,6 +33,8 @@
 
 #include <cutils/log.h>
 #include <dirent.h>
+#include <map>
+#include <wtf/CurrentTime.h>
 
 #undef ASSERT
 #define ASSERT(assertion, ...) do \
@@ -98,6 +100,67 @@ static std::string databaseDirectory(bool isPrivateBrowsing)
     return databaseFilePath;
 }
 
+// Told by the CookieMonster about every cookie added, changed, deleted or
+// expired, which is when the remembered strings go stale.
+class WebCookieJar::CookieStringCache : public net::CookieMonster::Delegate {
+public:
+    CookieStringCache()
+        : m_generation(0)
+    {
+    }
+
+    bool get(const std::string& key, std::string* cookies, unsigned* generation)
+    {
+        MutexLocker lock(m_mutex);
+        *generation = m_generation;
+        std::map<std::string, Entry>::const_iterator it = m_entries.find(key);
+        // A cookie can expire without the store hearing about it until it is
+        // next read, so answers are only trusted for a short while.
+        if (it == m_entries.end() || WTF::currentTime() - it->second.time > kMaxAge)
+            return false;
+        *cookies = it->second.cookies;
+        return true;
+    }
+
+    void set(const std::string& key, const std::string& cookies, unsigned generation)
+    {
+        MutexLocker lock(m_mutex);
+        // The store changed while the cookies were being looked up.
+        if (generation != m_generation)
+            return;
+        // When full, start over; the origins in use quickly come back.
+        if (m_entries.size() >= kMaxEntries)
+            m_entries.clear();
+        Entry& entry = m_entries[key];
+        entry.cookies = cookies;
+        entry.time = WTF::currentTime();
+    }
+
+    // CookieMonster::Delegate implementation from external/chromium
+    virtual void OnCookieChanged(const net::CookieMonster::CanonicalCookie&, bool)
+    {
+        MutexLocker lock(m_mutex);
+        m_entries.clear();
+        ++m_generation;
+    }
+
+private:
+    static const size_t kMaxEntries = 64;
+    // Cookie expiry has a granularity of a second.
+    static const double kMaxAge;
+
+    struct Entry {
+        std::string cookies;
+        double time;
+    };
+
+    std::map<std::string, Entry> m_entries;
+    unsigned m_generation;
+    WTF::Mutex m_mutex;
+};
+
+const double WebCookieJar::CookieStringCache::kMaxAge = 1;
+
 scoped_refptr<WebCookieJar>* instance(bool isPrivateBrowsing)
 {
     static scoped_refptr<WebCookieJar> regularInstance;
@@ -127,7 +190,8 @@ void WebCookieJar::cleanup(bool isPrivateBrowsing)
 }
 
 WebCookieJar::WebCookieJar(const std::string& databaseFilePath)
-    : m_allowCookies(true)
+    : m_cookieStringCache(new CookieStringCache())
+    , m_allowCookies(true)
 {
     // Setup the permissions for the file
     const char* cDatabasePath = databaseFilePath.c_str();
@@ -142,7 +206,31 @@ WebCookieJar::WebCookieJar(const std::string& databaseFilePath)
 
     FilePath cookiePath(databaseFilePath.c_str());
     m_cookieDb = new SQLitePersistentCookieStore(cookiePath);
-    m_cookieStore = new net::CookieMonster(m_cookieDb.get(), 0);
+    m_cookieStore = new net::CookieMonster(m_cookieDb.get(), m_cookieStringCache.get());
+}
+
+WebCookieJar::~WebCookieJar()
+{
+}
+
+std::string WebCookieJar::cookies(const GURL& url)
+{
+    // Which cookies match depends on the scheme, host, port and path only.
+    GURL::Replacements replacements;
+    replacements.ClearUsername();
+    replacements.ClearPassword();
+    replacements.ClearQuery();
+    replacements.ClearRef();
+    std::string key = url.ReplaceComponents(replacements).spec();
+
+    std::string cookies;
+    unsigned generation;
+    if (m_cookieStringCache->get(key, &cookies, &generation))
+        return cookies;
+
+    cookies = m_cookieStore->GetCookies(url);
+    m_cookieStringCache->set(key, cookies, generation);
+    return cookies;
 }
 
 bool WebCookieJar::allowCookies()
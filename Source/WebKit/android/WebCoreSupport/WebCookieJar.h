@@ -60,13 +60,24 @@ public:
     net::CookieStore* cookieStore() { return m_cookieStore.get(); }
     net::CookiePolicy* cookiePolicy() { return this; }
 
+    // The cookies document.cookie sees for |url|. Remembered per origin and
+    // path until the cookie store changes, so that scripts reading cookies in
+    // a loop do not make the store match and sort them each time.
+    std::string cookies(const GURL& url);
+
     // Get the number of cookies that have actually been saved to flash.
     // (This is used to implement CookieManager.hasCookies() in the Java framework.)
     int getNumCookiesInDatabase();
 
 private:
+    friend class base::RefCountedThreadSafe<WebCookieJar>;
+    class CookieStringCache;
+
     WebCookieJar(const std::string& databaseFilePath);
+    // Out of line, where CookieStringCache is defined.
+    ~WebCookieJar();
 
+    scoped_refptr<CookieStringCache> m_cookieStringCache;
     scoped_refptr<SQLitePersistentCookieStore> m_cookieDb;
     scoped_refptr<net::CookieStore> m_cookieStore;
     bool m_allowCookies;
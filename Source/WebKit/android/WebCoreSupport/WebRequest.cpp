@@ -30,6 +30,7 @@
 #include "JNIUtility.h"
 #include "MainThread.h"
 #include "UrlInterceptResponse.h"
+#include "WebCache.h"
 #include "WebCoreFrameBridge.h"
 #include "WebRequestContext.h"
 #include "WebResourceRequest.h"
@@ -41,6 +42,7 @@
 #include <string>
 #include <utils/AssetManager.h>
 #include <cutils/properties.h>
+#include <wtf/CurrentTime.h>
 
 extern android::AssetManager* globalAssetManager();
 
@@ -61,6 +63,11 @@ namespace android {
 
 namespace {
     const int kInitialReadBufSize = 32768;
+    // Reads are held back until this much data is waiting, or until the
+    // previous delivery is a frame old, whichever comes first. Every delivery
+    // is a task on the WebCore thread and a round of decoding or parsing.
+    const int kMaxPendingDataSize = 4 * kInitialReadBufSize;
+    const double kMaxDeliveryInterval = 0.016;
 }
 
 static bool ShouldSetRequestPriority()
@@ -94,6 +101,11 @@ WebRequest::WebRequest(WebUrlLoaderClient* loader, const WebResourceRequest& web
     , m_wantToPause(false)
     , m_isPaused(false)
     , m_isSync(false)
+    , m_pendingBytes(0)
+    , m_lastDeliveryTime(0)
+    , m_readCount(0)
+    , m_deliveryCount(0)
+    , m_deliveredBytes(0)
 {
     GURL gurl(m_url);
 
@@ -107,7 +119,14 @@ WebRequest::WebRequest(WebUrlLoaderClient* loader, const WebResourceRequest& web
     if (ShouldSetRequestPriority())
     {
         ResourceType::Type chromiumTargetType = convertWebkitTargetTypeToChromiumTargetType(webResourceRequest.target_type());
-        m_request->set_priority(net::DetermineRequestPriority(chromiumTargetType));
+        net::RequestPriority priority = net::DetermineRequestPriority(chromiumTargetType);
+        // WebCore may have raised the priority of the load since its type was
+        // decided, e.g. for a script the parser is waiting on or an image that
+        // is on screen. Lower values are more urgent.
+        net::RequestPriority webkitPriority = convertWebkitPriorityToChromiumPriority(webResourceRequest.priority());
+        if (webkitPriority < priority)
+            priority = webkitPriority;
+        m_request->set_priority(priority);
     }
 }
 
@@ -126,6 +145,11 @@ WebRequest::WebRequest(WebUrlLoaderClient* loader, const WebResourceRequest& web
     , m_wantToPause(false)
     , m_isPaused(false)
     , m_isSync(false)
+    , m_pendingBytes(0)
+    , m_lastDeliveryTime(0)
+    , m_readCount(0)
+    , m_deliveryCount(0)
+    , m_deliveredBytes(0)
 {
 }
 
@@ -169,6 +193,18 @@ void WebRequest::finish(bool success)
     android_printLog(ANDROID_LOG_DEBUG, "KM", "(%p) finish (%d) (%s) (%d) (%s)", this, --remaining, buffer, success, m_url.c_str());
 #endif
 
+    // Whatever has been read goes to WebCore before the load ends, unless
+    // WebCore itself cancelled the load.
+    if (m_loadState == Cancelled) {
+        m_pendingData.clear();
+        m_pendingBytes = 0;
+    } else
+        deliverData();
+#ifdef LOG_REQUESTS
+    android_printLog(ANDROID_LOG_DEBUG, "KM", "(%p) %d reads, %d deliveries, %lld bytes (%lld per delivery)", this,
+            m_readCount, m_deliveryCount, m_deliveredBytes, m_deliveryCount ? m_deliveredBytes / m_deliveryCount : 0);
+#endif
+
     // Make sure WebUrlLoaderClient doesn't delete us in the middle of this method.
     scoped_refptr<WebRequest> guard(this);
 
@@ -457,6 +493,10 @@ void WebRequest::OnResponseStarted(net::URLRequest* request)
 
     m_loadState = Response;
     if (request && request->status().is_success()) {
+        // The cache may just have stored or revalidated the entry for this url.
+        WebRequestContext* context = static_cast<WebRequestContext*>(request->context());
+        WebCache::get(context->isPrivateBrowsing())->invalidateCacheResult(request->url());
+
         OwnPtr<WebResponse> webResponse(new WebResponse(request));
         m_urlLoader->maybeCallOnMainThread(NewRunnableMethod(
                 m_urlLoader.get(), &WebUrlLoaderClient::didReceiveResponse, webResponse.release()));
@@ -520,6 +560,7 @@ void WebRequest::startReading()
         return;
 
     if (m_wantToPause) {
+        deliverData();
         m_isPaused = true;
         return;
     }
@@ -527,8 +568,12 @@ void WebRequest::startReading()
     int bytesRead = 0;
 
     if (!read(&bytesRead)) {
-        if (m_request && m_request->status().is_io_pending())
+        if (m_request && m_request->status().is_io_pending()) {
+            // The network has nothing more for now, so don't keep what we
+            // have from WebCore.
+            deliverData();
             return; // Wait for OnReadCompleted()
+        }
         return finish(false);
     }
 
@@ -538,8 +583,7 @@ void WebRequest::startReading()
 
     m_loadState = GotData;
     // Read ok, forward buffer to webcore
-    m_urlLoader->maybeCallOnMainThread(NewRunnableMethod(m_urlLoader.get(), &WebUrlLoaderClient::didReceiveData, m_networkBuffer, bytesRead));
-    m_networkBuffer = 0;
+    queueData(bytesRead);
     MessageLoop::current()->PostTask(FROM_HERE, m_runnableFactory.NewRunnableMethod(&WebRequest::startReading));
 }
 
@@ -553,6 +597,52 @@ bool WebRequest::read(int* bytesRead)
     return m_request->Read(m_networkBuffer, kInitialReadBufSize, bytesRead);
 }
 
+// Takes the data of the last read. It is delivered right away if enough data
+// has piled up or WebCore has not had any for a frame; otherwise it waits for
+// the next read, which startReading() delivers anyway once the network has to
+// wait for more.
+void WebRequest::queueData(int bytesRead)
+{
+    scoped_refptr<net::IOBuffer> buffer = m_networkBuffer;
+    m_networkBuffer = 0;
+    if (bytesRead <= 0)
+        return;
+
+    m_readCount++;
+    m_pendingData.push_back(std::make_pair(buffer, bytesRead));
+    m_pendingBytes += bytesRead;
+
+    if (m_pendingBytes >= kMaxPendingDataSize || WTF::currentTime() - m_lastDeliveryTime >= kMaxDeliveryInterval)
+        deliverData();
+}
+
+void WebRequest::deliverData()
+{
+    if (m_pendingData.empty())
+        return;
+
+    scoped_refptr<net::IOBuffer> buffer;
+    if (m_pendingData.size() == 1)
+        buffer = m_pendingData[0].first;
+    else {
+        // Copying here, on the IO thread, is cheaper than making WebCore
+        // process each read separately.
+        buffer = new net::IOBuffer(m_pendingBytes);
+        char* data = buffer->data();
+        for (size_t i = 0; i < m_pendingData.size(); ++i) {
+            memcpy(data, m_pendingData[i].first->data(), m_pendingData[i].second);
+            data += m_pendingData[i].second;
+        }
+    }
+    m_urlLoader->maybeCallOnMainThread(NewRunnableMethod(m_urlLoader.get(), &WebUrlLoaderClient::didReceiveData, buffer, m_pendingBytes));
+
+    m_deliveryCount++;
+    m_deliveredBytes += m_pendingBytes;
+    m_lastDeliveryTime = WTF::currentTime();
+    m_pendingData.clear();
+    m_pendingBytes = 0;
+}
+
 // This is called when there is data available
 
 // Called when the a Read of the response body is completed after an
@@ -568,9 +658,7 @@ void WebRequest::OnReadCompleted(net::URLRequest* request, int bytesRead)
 
     if (request->status().is_success()) {
         m_loadState = GotData;
-        m_urlLoader->maybeCallOnMainThread(NewRunnableMethod(
-                m_urlLoader.get(), &WebUrlLoaderClient::didReceiveData, m_networkBuffer, bytesRead));
-        m_networkBuffer = 0;
+        queueData(bytesRead);
 
         // Get the rest of the data
         startReading();
@@ -626,4 +714,24 @@ ResourceType::Type WebRequest::convertWebkitTargetTypeToChromiumTargetType(WebCo
     }
 }
 
+// Maps the WebCore priorities onto the network stack's so that a load keeps
+// the priority DetermineRequestPriority() gives its type unless WebCore
+// boosted it.
+net::RequestPriority WebRequest::convertWebkitPriorityToChromiumPriority(WebCore::ResourceLoadPriority webkitPriority)
+{
+    switch (webkitPriority)
+    {
+        case WebCore::ResourceLoadPriorityHighest:
+            return net::HIGHEST;
+
+        case WebCore::ResourceLoadPriorityMedium:
+            return net::MEDIUM;
+
+        case WebCore::ResourceLoadPriorityLow:
+        case WebCore::ResourceLoadPriorityVeryLow:
+        default:
+            return net::LOWEST;
+    }
+}
+
 } // namespace android
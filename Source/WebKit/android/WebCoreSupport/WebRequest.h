@@ -29,6 +29,8 @@
 
 #include "ChromiumIncludes.h"
 #include "ResourceRequestBase.h"
+#include <utility>
+#include <vector>
 #include <wtf/Vector.h>
 
 class MessageLoop;
@@ -96,6 +98,8 @@ public:
 private:
     void startReading();
     bool read(int* bytesRead);
+    void queueData(int bytesRead);
+    void deliverData();
 
     friend class base::RefCountedThreadSafe<WebRequest>;
     virtual ~WebRequest();
@@ -106,6 +110,7 @@ private:
     void updateLoadFlags(int& loadFlags);
 
     ResourceType::Type convertWebkitTargetTypeToChromiumTargetType(WebCore::ResourceRequestBase::TargetType webkitType);
+    net::RequestPriority convertWebkitPriorityToChromiumPriority(WebCore::ResourceLoadPriority webkitPriority);
 
     scoped_refptr<WebUrlLoaderClient> m_urlLoader;
     OwnPtr<net::URLRequest> m_request;
@@ -121,6 +126,15 @@ private:
     bool m_wantToPause;
     bool m_isPaused;
     bool m_isSync;
+
+    // Reads that have not been handed to WebCore yet. Reads that complete
+    // back to back are delivered together, see queueData().
+    std::vector<std::pair<scoped_refptr<net::IOBuffer>, int> > m_pendingData;
+    int m_pendingBytes;
+    double m_lastDeliveryTime;
+    int m_readCount;
+    int m_deliveryCount;
+    int64 m_deliveredBytes;
 #ifdef LOG_REQUESTS
     time_t m_startTime;
 #endif
@@ -48,6 +48,7 @@ public:
     int getCacheMode();
     static void setAcceptLanguage(const WTF::String&);
     static const WTF::String& acceptLanguage();
+    bool isPrivateBrowsing() const { return m_isPrivateBrowsing; }
 
 private:
     WebRequestContext();
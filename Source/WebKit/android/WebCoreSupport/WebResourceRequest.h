@@ -78,6 +78,11 @@ public:
         return m_type;
     }
 
+    WebCore::ResourceLoadPriority priority() const
+    {
+        return m_priority;
+    }
+
 private:
     std::string m_method;
     std::string m_referrer;
@@ -86,6 +91,7 @@ private:
     std::string m_url;
     int m_loadFlags;
     WebCore::ResourceRequestBase::TargetType m_type;
+    WebCore::ResourceLoadPriority m_priority;
 };
 
 } // namespace android
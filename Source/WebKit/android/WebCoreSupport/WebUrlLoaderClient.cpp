@@ -33,6 +33,7 @@
 #include "ResourceHandle.h"
 #include "ResourceHandleClient.h"
 #include "ResourceResponse.h"
+#include "SharedBuffer.h"
 #include "WebCoreFrameBridge.h"
 #include "WebRequest.h"
 #include "WebResourceRequest.h"
@@ -383,6 +384,37 @@ void WebUrlLoaderClient::didReceiveResponse(PassOwnPtr<WebResponse> webResponse)
     }
 }
 
+namespace {
+
+// Lets WebCore keep the data of a network read without copying it.
+class IOBufferSegment : public WebCore::SharedBufferSegment {
+public:
+    static PassRefPtr<IOBufferSegment> create(scoped_refptr<net::IOBuffer> buffer, int size)
+    {
+        return adoptRef(new IOBufferSegment(buffer, size));
+    }
+
+    virtual const char* data() const { return m_buffer->data(); }
+    virtual unsigned size() const { return m_size; }
+
+private:
+    IOBufferSegment(scoped_refptr<net::IOBuffer> buffer, int size)
+        : m_buffer(buffer)
+        , m_size(size)
+    {
+    }
+
+    scoped_refptr<net::IOBuffer> m_buffer;
+    unsigned m_size;
+};
+
+// A single read is handed over in a 32KB buffer however much it filled.
+// Smaller deliveries are copied so that WebCore does not keep the rest of
+// the buffer alive.
+const int kMinSegmentSize = 16384;
+
+} // namespace
+
 void WebUrlLoaderClient::didReceiveData(scoped_refptr<net::IOBuffer> buf, int size)
 {
     if (m_isMainResource && m_isCertMimeType) {
@@ -392,19 +424,59 @@ void WebUrlLoaderClient::didReceiveData(scoped_refptr<net::IOBuffer> buf, int si
     if (!isActive() || !size)
         return;
 
+    if (!m_resourceHandle || !m_resourceHandle->client())
+        return;
+
+    WebCore::ResourceHandleClient* client = m_resourceHandle->client();
+    if (size >= kMinSegmentSize && client->supportsDataSegments()) {
+        RefPtr<IOBufferSegment> segment = IOBufferSegment::create(buf, size);
+        client->didReceiveDataSegment(m_resourceHandle.get(), segment.get(), size);
+        return;
+    }
+
     // didReceiveData will take a copy of the data
-    if (m_resourceHandle && m_resourceHandle->client())
-        m_resourceHandle->client()->didReceiveData(m_resourceHandle.get(), buf->data(), size, size);
+    client->didReceiveData(m_resourceHandle.get(), buf->data(), size, size);
 }
 
+// The decoded payload of a data url, which the IO thread no longer needs.
+class StringSegment : public WebCore::SharedBufferSegment {
+public:
+    static PassRefPtr<StringSegment> create(PassOwnPtr<std::string> string)
+    {
+        return adoptRef(new StringSegment(string));
+    }
+
+    virtual const char* data() const { return m_string->data(); }
+    virtual unsigned size() const { return m_string->size(); }
+
+private:
+    StringSegment(PassOwnPtr<std::string> string)
+        : m_string(string)
+    {
+    }
+
+    OwnPtr<std::string> m_string;
+};
+
 // For data url's
 void WebUrlLoaderClient::didReceiveDataUrl(PassOwnPtr<std::string> str)
 {
     if (!isActive() || !str->size())
         return;
 
+    // Data urls were decoded on the IO thread; hand the result over rather
+    // than copying it. Pages that inline many images or fonts pay for every
+    // copy on this thread.
+    WebCore::ResourceHandleClient* client = m_resourceHandle->client();
+    int size = str->size();
+    if (client->supportsDataSegments()) {
+        RefPtr<StringSegment> segment = StringSegment::create(str);
+        client->didReceiveDataSegment(m_resourceHandle.get(), segment.get(), size);
+        return;
+    }
+
     // didReceiveData will take a copy of the data
-    m_resourceHandle->client()->didReceiveData(m_resourceHandle.get(), str->data(), str->size(), str->size());
+    client->didReceiveData(m_resourceHandle.get(), str->data(), size, size);
 }
 
 // For special android files
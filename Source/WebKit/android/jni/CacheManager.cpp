@@ -76,18 +76,12 @@ static String getCacheFileBaseDir(JNIEnv* env)
     return baseDir;
 }
 
-static jobject getCacheResult(JNIEnv* env, jobject, jstring url)
+static jobject createJavaCacheResult(JNIEnv* env, const String& urlWtfString, CacheResult* result)
 {
-    // This is called on the UI thread.
-    scoped_refptr<CacheResult> result = WebCache::get(false /*privateBrowsing*/)->getCacheResult(jstringToWtfString(env, url));
-    if (!result)
-        return 0;
-
     // We create and populate a file with the cache entry. This allows us to
     // replicate the behaviour of the Android HTTP stack in the Java
     // CacheManager, which opens the cache file and provides an input stream to
     // the file as part of the Java CacheResult object!
-    String urlWtfString = jstringToWtfString(env, url);
     Vector<char> encodedUrl;
     base64Encode(urlWtfString.utf8().data(), urlWtfString.length(), encodedUrl, false /*insertLFs*/);
     encodedUrl.append('\0');
@@ -111,24 +105,68 @@ static jobject getCacheResult(JNIEnv* env, jobject, jstring url)
     jfieldID mimeTypeField = env->GetFieldID(cacheResultClass, "mimeType", "Ljava/lang/String;");
 
     jobject javaResult = env->NewObject(cacheResultClass, constructor);
-    setFieldFromHeaderIfPresent(result.get(), "content-disposition", env, javaResult, contentdispositionField, true);
+    setFieldFromHeaderIfPresent(result, "content-disposition", env, javaResult, contentdispositionField, true);
     env->SetLongField(javaResult, contentLengthField, result->contentSize());
-    setFieldFromHeaderIfPresent(result.get(), "etag", env, javaResult, etagField, false);
+    setFieldFromHeaderIfPresent(result, "etag", env, javaResult, etagField, false);
     setStringField(env, javaResult, encodingField, "TODO"); // TODO: Where does the Android stack set this?
     env->SetLongField(javaResult, expiresField, result->expires());
     env->SetIntField(javaResult, httpStatusCodeField, result->responseCode());
-    setFieldFromHeaderIfPresent(result.get(), "last-modified", env, javaResult, lastModifiedField, false);
+    setFieldFromHeaderIfPresent(result, "last-modified", env, javaResult, lastModifiedField, false);
     setStringField(env, javaResult, localPathField, encodedUrl.data());
-    setFieldFromHeaderIfPresent(result.get(), "location", env, javaResult, locationField, false);
+    setFieldFromHeaderIfPresent(result, "location", env, javaResult, locationField, false);
     setStringField(env, javaResult, mimeTypeField, result->mimeType());
 
+    env->DeleteLocalRef(cacheResultClass);
     return javaResult;
 }
 
+static jobject getCacheResult(JNIEnv* env, jobject, jstring url)
+{
+    // This is called on the UI thread.
+    String urlWtfString = jstringToWtfString(env, url);
+    scoped_refptr<CacheResult> result = WebCache::get(false /*privateBrowsing*/)->getCacheResult(urlWtfString);
+    if (!result)
+        return 0;
+    return createJavaCacheResult(env, urlWtfString, result.get());
+}
+
+static jobjectArray getCacheResults(JNIEnv* env, jobject, jobjectArray urls)
+{
+    // This is called on the UI thread. All the entries are opened in a single
+    // trip to the IO thread.
+    jsize count = env->GetArrayLength(urls);
+    Vector<String> urlWtfStrings;
+    for (jsize i = 0; i < count; ++i) {
+        jstring url = static_cast<jstring>(env->GetObjectArrayElement(urls, i));
+        urlWtfStrings.append(url ? jstringToWtfString(env, url) : String());
+        env->DeleteLocalRef(url);
+    }
+
+    Vector<scoped_refptr<CacheResult> > results;
+    WebCache::get(false /*privateBrowsing*/)->getCacheResults(urlWtfStrings, results);
+
+    jclass cacheResultClass = env->FindClass("android/webkit/CacheManager$CacheResult");
+    jobjectArray javaResults = env->NewObjectArray(count, cacheResultClass, 0);
+    env->DeleteLocalRef(cacheResultClass);
+    for (jsize i = 0; i < count; ++i) {
+        if (!results[i])
+            continue;
+        jobject javaResult = createJavaCacheResult(env, urlWtfStrings[i], results[i].get());
+        env->SetObjectArrayElement(javaResults, i, javaResult);
+        env->DeleteLocalRef(javaResult);
+    }
+    return javaResults;
+}
+
 static JNINativeMethod gCacheManagerMethods[] = {
     { "nativeGetCacheResult", "(Ljava/lang/String;)Landroid/webkit/CacheManager$CacheResult;", (void*) getCacheResult },
 };
 
+// Only frameworks whose CacheManager declares the batch lookup get it.
+static JNINativeMethod gCacheManagerBatchMethods[] = {
+    { "nativeGetCacheResults", "([Ljava/lang/String;)[Landroid/webkit/CacheManager$CacheResult;", (void*) getCacheResults },
+};
+
 int registerCacheManager(JNIEnv* env)
 {
 #ifndef NDEBUG
@@ -136,7 +174,15 @@ int registerCacheManager(JNIEnv* env)
     LOG_ASSERT(cacheManager, "Unable to find class");
     env->DeleteLocalRef(cacheManager);
 #endif
-    return jniRegisterNativeMethods(env, javaCacheManagerClass, gCacheManagerMethods, NELEM(gCacheManagerMethods));
+    int result = jniRegisterNativeMethods(env, javaCacheManagerClass, gCacheManagerMethods, NELEM(gCacheManagerMethods));
+    if (result < 0)
+        return result;
+
+    jclass cacheManager = env->FindClass(javaCacheManagerClass);
+    if (env->RegisterNatives(cacheManager, gCacheManagerBatchMethods, NELEM(gCacheManagerBatchMethods)) < 0)
+        env->ExceptionClear();
+    env->DeleteLocalRef(cacheManager);
+    return result;
 }
 
 } // namespace android
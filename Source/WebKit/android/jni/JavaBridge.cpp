@@ -405,6 +405,19 @@ void JavaBridge::SetCacheSize(JNIEnv* env, jobject obj, jint bytes)
             minDeadSize = 0;
             maxDeadSize = bytes/2;
         }
+
+        // Decoded images are the bulk of the cache and the most expensive to
+        // bring back on these devices, so evict by cost unless told not to.
+        property_get("net.webkit.cache.costaware", value, "1");
+        WebCore::memoryCache()->setEvictionPolicy(atoi(value) ? WebCore::MemoryCache::CostAwareEvictionPolicy : WebCore::MemoryCache::LRUEvictionPolicy);
+        // The weights of its cost model, in bytes; unset keeps the default.
+        property_get("net.webkit.cache.decodecost", value, "0");
+        double decodeSecondCost = atof(value);
+        property_get("net.webkit.cache.encodedcost", value, "0");
+        double encodedByteCost = atof(value);
+        property_get("net.webkit.cache.parsedcost", value, "0");
+        double parsedByteCost = atof(value);
+        WebCore::memoryCache()->setEvictionCostWeights(decodeSecondCost, encodedByteCost, parsedByteCost);
     }
     WebCore::memoryCache()->setCapacities(minDeadSize, maxDeadSize, bytes);
 }
@@ -581,7 +581,12 @@ public:
         size = env->GetIntField(obj, gFieldIds->mPageCacheCapacity);
         if (size > 0) {
             s->setUsesPageCache(true);
+            // Only the most recent page keeps its render tree. The capacity
+            // is not raised to make use of the memory that saves: what a
+            // compacted page still holds (DOM, JS heap, FrameView) has not
+            // been measured, so no page count can be derived from it yet.
             WebCore::pageCache()->setCapacity(size);
+            WebCore::pageCache()->setRenderedCapacity(1);
         } else
             s->setUsesPageCache(false);
 
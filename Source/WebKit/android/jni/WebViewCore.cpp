@@ -158,6 +158,8 @@ FILE* gRenderTreeFile = 0;
 #endif
 
 #ifdef ANDROID_INSTRUMENT
+#include "AndroidLog.h"
+#include "LayoutProfiler.h"
 #include "TimeCounter.h"
 #endif
 
@@ -1467,6 +1469,30 @@ void WebViewCore::dumpRenderTree(bool useFile)
         }
     }
 #endif
+#ifdef ANDROID_INSTRUMENT
+    if (!WebCore::LayoutProfiler::isEnabled())
+        return;
+    WTF::CString profile = WebCore::LayoutProfiler::toJSON().utf8();
+    if (useFile) {
+        FILE* file = fopen(LAYOUT_PROFILE_LOG_FILE, "w");
+        if (file) {
+            fwrite(profile.data(), 1, profile.length(), file);
+            fclose(file);
+        }
+    } else {
+        const char* data = profile.data();
+        int length = profile.length();
+        for (int i = 0, last = 0; i < length; i++) {
+            if (data[i] == '\n') {
+                if (i != last)
+                    LOGD("%.*s", (i - last), &(data[last]));
+                last = i + 1;
+            }
+        }
+    }
+    // The next dump starts from here.
+    WebCore::LayoutProfiler::reset();
+#endif
 }
 
 void WebViewCore::dumpNavTree()
@@ -41,6 +41,7 @@
 #include "IntPoint.h"
 #include "IntRect.h"
 #include "LayerAndroid.h"
+#include "MemoryPressure.h"
 #include "Node.h"
 #include "utils/Functor.h"
 #include "private/hwui/DrawGlInfo.h"
@@ -79,14 +80,6 @@
 #include "Renderer.h"
 #endif
 
-// Free as much as we possible can
-#define TRIM_MEMORY_COMPLETE 80
-// Free a lot (all textures gone)
-#define TRIM_MEMORY_MODERATE 60
-// More moderate free (keep bare minimum to restore quickly-ish - possibly clear all textures)
-#define TRIM_MEMORY_BACKGROUND 40
-// Moderate free (clear cached tiles, keep visible ones)
-#define TRIM_MEMORY_UI_HIDDEN 20
 // Duration to show the pressed cursor ring
 #define PRESSED_STATE_DURATION 400
 
@@ -2678,10 +2671,7 @@ static jstring nativeGetProperty(JNIEnv *env, jobject obj, jstring key)
 
 static void nativeOnTrimMemory(JNIEnv *env, jobject obj, jint level)
 {
-    if (TilesManager::hardwareAccelerationEnabled()) {
-        bool freeAllTextures = (level > TRIM_MEMORY_UI_HIDDEN);
-        TilesManager::instance()->deallocateTextures(freeAllTextures);
-    }
+    MemoryPressure::onTrimMemory(level);
 }
 
 static void nativeDumpDisplayTree(JNIEnv* env, jobject jwebview, jstring jurl)
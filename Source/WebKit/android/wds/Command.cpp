@@ -31,6 +31,7 @@
 #include "Connection.h"
 #include "DebugServer.h"
 #include "Frame.h"
+#include "LayoutProfiler.h"
 #include "RenderTreeAsText.h"
 #include "RenderView.h"
 #include "WebViewCore.h"
@@ -73,6 +74,29 @@ static bool callDumpDomTree(const Frame* frame, const Connection* conn) {
     return true;
 }
 
+static bool callDumpLayoutProfile(const Frame* frame, const Connection* conn) {
+#ifdef ANDROID_INSTRUMENT
+    CString str = LayoutProfiler::toJSON().utf8();
+    conn->write(str.data(), str.length());
+    // The next dump starts from here.
+    LayoutProfiler::reset();
+#else
+    conn->write("Layout profiler requires WEBCORE_INSTRUMENTATION\n");
+#endif
+    return true;
+}
+
+static bool callToggleLayoutProfiler(const Frame* frame, const Connection* conn) {
+#ifdef ANDROID_INSTRUMENT
+    bool enabled = !LayoutProfiler::isEnabled();
+    LayoutProfiler::setEnabled(enabled);
+    conn->write(enabled ? "Layout profiler enabled\n" : "Layout profiler disabled\n");
+#else
+    conn->write("Layout profiler requires WEBCORE_INSTRUMENTATION\n");
+#endif
+    return true;
+}
+
 class WebCoreHandler : public Handler {
 public:
     virtual void post(TargetThreadFunction func, void* v) const {
@@ -128,6 +152,10 @@ void Command::Init() {
                 callDumpDomTree, s_webcoreHandler));
     s_commands->append(new Command("DDRT", "Dump Render Tree",
                 callDumpRenderTree, s_webcoreHandler));
+    s_commands->append(new Command("DLPF", "Dump Layout Profile",
+                callDumpLayoutProfile, s_webcoreHandler));
+    s_commands->append(new Command("TLPF", "Toggle Layout Profiler",
+                callToggleLayoutProfiler, s_webcoreHandler));
 }
 
 Command* Command::Find(const Connection* conn) {